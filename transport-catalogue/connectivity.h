@@ -0,0 +1,206 @@
+#pragma once
+
+#include "graph.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace graph {
+
+    // Компоненты связности графа для отсечения заведомо невозможных запросов без поиска.
+    // Сильные компоненты нумеруются алгоритмом Тарьяна в обратном топологическом порядке:
+    // если путь from -> to существует, номер компоненты from не меньше номера компоненты to.
+    // Слабые компоненты - компоненты графа без учёта направления рёбер, между ними путей нет вовсе
+    class Connectivity {
+    public:
+        struct ComponentsData {
+            std::vector<uint32_t> strong_components;
+            std::vector<uint32_t> weak_components;
+        };
+
+        // Только для замороженного графа
+        template <typename Weight>
+        explicit Connectivity(const DirectedWeightedGraph<Weight>& graph);
+        // Создаёт индекс по ранее рассчитанным компонентам
+        explicit Connectivity(ComponentsData&& components_data);
+
+        // false - пути from -> to точно нет, true - путь может существовать
+        bool MayReach(VertexId from, VertexId to) const;
+
+        const ComponentsData& GetComponentsData() const;
+        size_t GetVertexCount() const;
+        size_t GetStrongComponentCount() const;
+        size_t GetWeakComponentCount() const;
+        size_t GetMemoryUsage() const;
+
+    private:
+        static constexpr uint32_t UNVISITED = std::numeric_limits<uint32_t>::max();
+
+        ComponentsData components_data_;
+        size_t strong_component_count_ = 0;
+        size_t weak_component_count_ = 0;
+
+        template <typename Weight>
+        void ComputeStrongComponents(const DirectedWeightedGraph<Weight>& graph);
+        template <typename Weight>
+        void ComputeWeakComponents(const DirectedWeightedGraph<Weight>& graph);
+        static size_t CountComponents(const std::vector<uint32_t>& components);
+    };
+
+    template <typename Weight>
+    Connectivity::Connectivity(const DirectedWeightedGraph<Weight>& graph) {
+        if (!graph.IsFrozen()) {
+            throw std::logic_error("Graph must be frozen before computing components");
+        }
+        ComputeStrongComponents(graph);
+        ComputeWeakComponents(graph);
+    }
+
+    inline Connectivity::Connectivity(ComponentsData&& components_data)
+        : components_data_(std::move(components_data))
+    {
+        if (components_data_.strong_components.size() != components_data_.weak_components.size()) {
+            throw std::invalid_argument("Graph components are inconsistent");
+        }
+        strong_component_count_ = CountComponents(components_data_.strong_components);
+        weak_component_count_ = CountComponents(components_data_.weak_components);
+    }
+
+    template <typename Weight>
+    void Connectivity::ComputeStrongComponents(const DirectedWeightedGraph<Weight>& graph) {
+        const size_t vertex_count = graph.GetVertexCount();
+        std::vector<uint32_t>& components = components_data_.strong_components;
+        components.assign(vertex_count, UNVISITED);
+
+        // Алгоритм Тарьяна без рекурсии: для каждой вершины стека вызовов хранится позиция следующего ребра
+        std::vector<uint32_t> order(vertex_count, UNVISITED);
+        std::vector<uint32_t> lowlink(vertex_count, 0);
+        std::vector<uint32_t> component_stack;
+        std::vector<std::pair<VertexId, size_t>> call_stack;
+        uint32_t next_order = 0;
+
+        for (VertexId root = 0; root < vertex_count; ++root) {
+            if (order[root] != UNVISITED) {
+                continue;
+            }
+            order[root] = lowlink[root] = next_order++;
+            component_stack.push_back(static_cast<uint32_t>(root));
+            call_stack.emplace_back(root, 0);
+
+            while (!call_stack.empty()) {
+                auto& [vertex, position] = call_stack.back();
+                const IncidentArcs<Weight> arcs = graph.GetIncidentArcs(vertex);
+                if (position < arcs.count) {
+                    const VertexId target = arcs.targets[position++];
+                    if (order[target] == UNVISITED) {
+                        order[target] = lowlink[target] = next_order++;
+                        component_stack.push_back(static_cast<uint32_t>(target));
+                        call_stack.emplace_back(target, 0);
+                    }
+                    else if (components[target] == UNVISITED) {
+                        // Вершина ещё в стеке компоненты
+                        lowlink[vertex] = std::min(lowlink[vertex], order[target]);
+                    }
+                    continue;
+                }
+
+                // Все рёбра просмотрены: вершина - корень компоненты, если из её поддерева нет пути выше
+                const VertexId finished = vertex;
+                call_stack.pop_back();
+                if (lowlink[finished] == order[finished]) {
+                    uint32_t member;
+                    do {
+                        member = component_stack.back();
+                        component_stack.pop_back();
+                        components[member] = static_cast<uint32_t>(strong_component_count_);
+                    } while (member != finished);
+                    ++strong_component_count_;
+                }
+                if (!call_stack.empty()) {
+                    const VertexId parent = call_stack.back().first;
+                    lowlink[parent] = std::min(lowlink[parent], lowlink[finished]);
+                }
+            }
+        }
+    }
+
+    template <typename Weight>
+    void Connectivity::ComputeWeakComponents(const DirectedWeightedGraph<Weight>& graph) {
+        const size_t vertex_count = graph.GetVertexCount();
+
+        // Система непересекающихся множеств со сжатием путей
+        std::vector<uint32_t> parents(vertex_count);
+        std::iota(parents.begin(), parents.end(), 0);
+        auto find_root = [&parents](uint32_t vertex) {
+            while (parents[vertex] != vertex) {
+                parents[vertex] = parents[parents[vertex]];
+                vertex = parents[vertex];
+            }
+            return vertex;
+        };
+        for (const auto& edge : graph.GetEdges()) {
+            const uint32_t from_root = find_root(static_cast<uint32_t>(edge.from));
+            const uint32_t to_root = find_root(static_cast<uint32_t>(edge.to));
+            if (from_root != to_root) {
+                parents[std::max(from_root, to_root)] = std::min(from_root, to_root);
+            }
+        }
+
+        // Номера компонент подряд в порядке первой вершины компоненты
+        std::vector<uint32_t>& components = components_data_.weak_components;
+        components.assign(vertex_count, UNVISITED);
+        for (uint32_t vertex = 0; vertex < vertex_count; ++vertex) {
+            const uint32_t root = find_root(vertex);
+            if (components[root] == UNVISITED) {
+                components[root] = static_cast<uint32_t>(weak_component_count_++);
+            }
+            components[vertex] = components[root];
+        }
+    }
+
+    inline size_t Connectivity::CountComponents(const std::vector<uint32_t>& components) {
+        size_t count = 0;
+        for (const uint32_t component : components) {
+            if (component >= components.size()) {
+                throw std::invalid_argument("Graph components are inconsistent");
+            }
+            count = std::max<size_t>(count, component + 1);
+        }
+        return count;
+    }
+
+    inline bool Connectivity::MayReach(VertexId from, VertexId to) const {
+        if (from >= GetVertexCount() || to >= GetVertexCount()) {
+            throw std::out_of_range("Vertex is out of graph");
+        }
+        return components_data_.weak_components[from] == components_data_.weak_components[to]
+            && components_data_.strong_components[from] >= components_data_.strong_components[to];
+    }
+
+    inline const Connectivity::ComponentsData& Connectivity::GetComponentsData() const {
+        return components_data_;
+    }
+
+    inline size_t Connectivity::GetVertexCount() const {
+        return components_data_.strong_components.size();
+    }
+
+    inline size_t Connectivity::GetStrongComponentCount() const {
+        return strong_component_count_;
+    }
+
+    inline size_t Connectivity::GetWeakComponentCount() const {
+        return weak_component_count_;
+    }
+
+    inline size_t Connectivity::GetMemoryUsage() const {
+        return (components_data_.strong_components.capacity() + components_data_.weak_components.capacity())
+            * sizeof(uint32_t);
+    }
+
+}  // namespace graph
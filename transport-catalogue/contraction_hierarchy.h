@@ -0,0 +1,540 @@
+#pragma once
+
+#include "graph.h"
+#include "router.h"
+#include "dijkstra_router.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace graph {
+
+    // Класс, реализующий поиск кратчайшего пути по иерархии сжатия (Contraction Hierarchies).
+    // При построении вершины сжимаются по одной в порядке важности, а кратчайшие пути через сжатую вершину
+    // заменяются рёбрами-сокращениями. Запрос - двунаправленный поиск только "вверх" по иерархии,
+    // найденные сокращения разворачиваются обратно в исходные рёбра графа.
+    template <typename Weight>
+    class ContractionHierarchy {
+    private:
+        using Graph = DirectedWeightedGraph<Weight>;
+        using Workspace = SearchWorkspace<Weight>;
+
+    public:
+        using RouteInfo = typename Router<Weight>::RouteInfo;
+
+        // Ребро-сокращение from -> to, заменяющее путь из двух рёбер first_edge и second_edge.
+        // Id сокращения - кол-во рёбер графа + его индекс, поэтому first_edge и second_edge
+        // могут быть как исходными рёбрами, так и другими сокращениями
+        struct Shortcut {
+            VertexId from;
+            VertexId to;
+            Weight weight;
+            EdgeId first_edge;
+            EdgeId second_edge;
+        };
+
+        struct HierarchyData {
+            // Порядковый номер сжатия каждой вершины
+            std::vector<uint32_t> ranks;
+            std::vector<Shortcut> shortcuts;
+        };
+
+        explicit ContractionHierarchy(const Graph& graph);
+        // Создаёт маршрутизатор по ранее построенной иерархии, без повторного сжатия
+        ContractionHierarchy(const Graph& graph, HierarchyData&& hierarchy_data);
+
+        std::optional<RouteInfo> BuildRoute(VertexId from, VertexId to) const;
+
+        const HierarchyData& GetHierarchyData() const;
+
+        // Вызывает func(vertex_to, weight) для каждой дуги, ведущей из vertex к вершине более высокого ранга.
+        // forward - рёбра и сокращения vertex -> vertex_to, иначе рёбра vertex_to -> vertex
+        template <typename Func>
+        void ForEachUpwardArc(VertexId vertex, bool forward, Func func) const;
+
+    private:
+        static constexpr Weight ZERO_WEIGHT{};
+
+        // Дуга графа поиска: вершина на другом конце, вес и id ребра или сокращения
+        struct Arc {
+            VertexId vertex;
+            Weight weight;
+            EdgeId edge_id;
+        };
+
+        // Граф поиска в виде CSR: дуги вершины v - arcs[offsets[v]] ... arcs[offsets[v + 1] - 1]
+        struct SearchGraph {
+            std::vector<size_t> offsets;
+            std::vector<Arc> arcs;
+        };
+
+        class Contractor;
+
+        const Graph& graph_;
+        HierarchyData hierarchy_data_;
+        // Прямой граф: рёбра u -> x, ведущие вверх (rank x > rank u), хранятся у u.
+        // Обратный граф: рёбра u -> x, ведущие вниз (rank u > rank x), хранятся у x
+        SearchGraph forward_graph_;
+        SearchGraph backward_graph_;
+
+        void BuildSearchGraphs();
+        VertexId GetEdgeFrom(EdgeId edge_id) const;
+        VertexId GetEdgeTo(EdgeId edge_id) const;
+        // Разворачивает ребро или сокращение в последовательность исходных рёбер графа
+        void UnpackEdge(EdgeId edge_id, std::vector<EdgeId>& edges) const;
+        // Один шаг поиска: извлекает ближайшую вершину и релаксирует её дуги
+        static void SearchStep(Workspace& workspace, const Workspace& opposite, const SearchGraph& search_graph,
+            Weight& best_weight, VertexId& meeting_vertex);
+
+        static std::pair<Workspace, Workspace>& GetWorkspaces(size_t vertex_count);
+    };
+
+    // Построение иерархии: порядок сжатия вершин и рёбра-сокращения
+    template <typename Weight>
+    class ContractionHierarchy<Weight>::Contractor {
+    public:
+        Contractor(const Graph& graph, HierarchyData& hierarchy_data);
+
+        void Run();
+
+    private:
+        // Предел кол-ва дуг, просматриваемых поиском свидетеля. Если свидетель не найден
+        // за этот предел, сокращение добавляется: это не влияет на корректность, только на размер иерархии
+        static constexpr size_t WITNESS_ARC_LIMIT = 1000;
+        // При оценке приоритета вершины достаточно более грубого поиска
+        static constexpr size_t SIMULATION_WITNESS_ARC_LIMIT = 100;
+        // Сколько вершин подряд можно отложить при ленивом обновлении приоритетов.
+        // В плотной части графа сжатие каждой вершины повышает приоритет почти всех оставшихся,
+        // и без предела очередь перебирала бы их все перед каждым сжатием
+        static constexpr size_t LAZY_UPDATE_LIMIT = 16;
+
+        // Дуга графа в процессе сжатия
+        struct ContractionArc {
+            VertexId from;
+            VertexId to;
+            Weight weight;
+            EdgeId edge_id;
+        };
+
+        const Graph& graph_;
+        HierarchyData& hierarchy_data_;
+        // Дуги между ещё не сжатыми вершинами, по одной (лучшей) на пару вершин.
+        // Списки вершин хранят индексы дуг в arcs_, индекс дуги по паре вершин - в arc_indexes_
+        std::vector<ContractionArc> arcs_;
+        std::unordered_map<uint64_t, size_t> arc_indexes_;
+        std::vector<std::vector<size_t>> out_arcs_;
+        std::vector<std::vector<size_t>> in_arcs_;
+        std::vector<int> contracted_neighbors_;
+        Workspace witness_workspace_;
+
+        static uint64_t GetArcKey(VertexId from, VertexId to);
+        void AddArc(VertexId from, VertexId to, Weight weight, EdgeId edge_id);
+        // Ищет пути из source в обход вершины excluded, не длиннее limit
+        void WitnessSearch(VertexId source, VertexId excluded, Weight limit, size_t arc_limit);
+        // Сжимает вершину, добавляя необходимые сокращения. При simulate только считает их
+        size_t ContractVertex(VertexId vertex, bool simulate);
+        int ComputePriority(VertexId vertex);
+        // Удаляет дуги сжатой вершины из графа
+        void RemoveVertex(VertexId vertex);
+    };
+
+    template <typename Weight>
+    ContractionHierarchy<Weight>::Contractor::Contractor(const Graph& graph, HierarchyData& hierarchy_data)
+        : graph_(graph)
+        , hierarchy_data_(hierarchy_data)
+        , out_arcs_(graph.GetVertexCount())
+        , in_arcs_(graph.GetVertexCount())
+        , contracted_neighbors_(graph.GetVertexCount(), 0)
+    {
+        witness_workspace_.Prepare(graph.GetVertexCount());
+        arcs_.reserve(graph.GetEdgeCount());
+        arc_indexes_.reserve(graph.GetEdgeCount());
+        for (EdgeId edge_id = 0; edge_id < graph.GetEdgeCount(); ++edge_id) {
+            const auto& edge = graph.GetEdge(edge_id);
+            if (edge.weight < ZERO_WEIGHT) {
+                throw std::domain_error("Edges' weights should be non-negative");
+            }
+            if (edge.from != edge.to) {
+                AddArc(edge.from, edge.to, edge.weight, edge_id);
+            }
+        }
+    }
+
+    template <typename Weight>
+    uint64_t ContractionHierarchy<Weight>::Contractor::GetArcKey(VertexId from, VertexId to) {
+        return (static_cast<uint64_t>(from) << 32) | static_cast<uint32_t>(to);
+    }
+
+    template <typename Weight>
+    void ContractionHierarchy<Weight>::Contractor::AddArc(VertexId from, VertexId to, Weight weight, EdgeId edge_id) {
+        const auto [it, inserted] = arc_indexes_.emplace(GetArcKey(from, to), arcs_.size());
+        if (inserted) {
+            arcs_.push_back({ from, to, weight, edge_id });
+            out_arcs_[from].push_back(it->second);
+            in_arcs_[to].push_back(it->second);
+        }
+        else if (weight < arcs_[it->second].weight) {
+            arcs_[it->second].weight = weight;
+            arcs_[it->second].edge_id = edge_id;
+        }
+    }
+
+    template <typename Weight>
+    void ContractionHierarchy<Weight>::Contractor::WitnessSearch(VertexId source, VertexId excluded, Weight limit,
+        size_t arc_limit) {
+        witness_workspace_.Update(source, ZERO_WEIGHT, Workspace::NO_EDGE);
+        // Найденные расстояния - длины реальных путей, поэтому поиск можно прервать в любой момент
+        size_t arcs_left = arc_limit;
+        typename Workspace::HeapItem item;
+        while (arcs_left > 0 && witness_workspace_.PopNearest(item)) {
+            const auto [distance, vertex] = item;
+            if (limit < distance) {
+                break;
+            }
+            for (const size_t arc_index : out_arcs_[vertex]) {
+                if (arcs_left == 0) {
+                    break;
+                }
+                --arcs_left;
+                const ContractionArc& arc = arcs_[arc_index];
+                const Weight candidate = distance + arc.weight;
+                if (arc.to != excluded && !(limit < candidate)) {
+                    witness_workspace_.Update(arc.to, candidate, arc.edge_id);
+                }
+            }
+        }
+    }
+
+    template <typename Weight>
+    size_t ContractionHierarchy<Weight>::Contractor::ContractVertex(VertexId vertex, bool simulate) {
+        size_t shortcut_count = 0;
+        // Сокращения from -> to меняют только списки дуг соседей, но не самой вершины.
+        // arcs_ при этом может перераспределить память, поэтому дуги копируются по значению
+        const std::vector<size_t>& in_arcs = in_arcs_[vertex];
+        const std::vector<size_t>& out_arcs = out_arcs_[vertex];
+
+        for (const size_t in_index : in_arcs) {
+            const ContractionArc in_arc = arcs_[in_index];
+            // Свидетель нужен только для вершин, в которые есть дуги не только из сжимаемой вершины
+            Weight limit = ZERO_WEIGHT;
+            bool needs_witness = false;
+            for (const size_t out_index : out_arcs) {
+                const ContractionArc& out_arc = arcs_[out_index];
+                if (out_arc.to != in_arc.from && in_arcs_[out_arc.to].size() > 1) {
+                    limit = std::max(limit, in_arc.weight + out_arc.weight);
+                    needs_witness = true;
+                }
+            }
+
+            if (needs_witness) {
+                WitnessSearch(in_arc.from, vertex, limit, simulate ? SIMULATION_WITNESS_ARC_LIMIT : WITNESS_ARC_LIMIT);
+            }
+            for (const size_t out_index : out_arcs) {
+                const ContractionArc out_arc = arcs_[out_index];
+                if (out_arc.to == in_arc.from) {
+                    continue;
+                }
+                const Weight via_weight = in_arc.weight + out_arc.weight;
+                // Есть путь в обход сжимаемой вершины, не длиннее пути через неё
+                if (!(via_weight < witness_workspace_.distance[out_arc.to])) {
+                    continue;
+                }
+                ++shortcut_count;
+                if (!simulate) {
+                    const EdgeId shortcut_id = graph_.GetEdgeCount() + hierarchy_data_.shortcuts.size();
+                    hierarchy_data_.shortcuts.push_back({ in_arc.from, out_arc.to, via_weight, in_arc.edge_id, out_arc.edge_id });
+                    AddArc(in_arc.from, out_arc.to, via_weight, shortcut_id);
+                }
+            }
+            witness_workspace_.Reset();
+        }
+
+        return shortcut_count;
+    }
+
+    template <typename Weight>
+    int ContractionHierarchy<Weight>::Contractor::ComputePriority(VertexId vertex) {
+        const int degree = static_cast<int>(in_arcs_[vertex].size() + out_arcs_[vertex].size());
+        // Разность рёбер: сколько сокращений добавится взамен удаляемых дуг,
+        // плюс кол-во уже сжатых соседей, чтобы сжатие шло равномерно по графу
+        return static_cast<int>(ContractVertex(vertex, true)) - degree + contracted_neighbors_[vertex];
+    }
+
+    template <typename Weight>
+    void ContractionHierarchy<Weight>::Contractor::RemoveVertex(VertexId vertex) {
+        auto remove_index = [](std::vector<size_t>& arc_indexes, size_t removed) {
+            arc_indexes.erase(std::find(arc_indexes.begin(), arc_indexes.end(), removed));
+        };
+        for (const size_t arc_index : in_arcs_[vertex]) {
+            const VertexId neighbor = arcs_[arc_index].from;
+            ++contracted_neighbors_[neighbor];
+            remove_index(out_arcs_[neighbor], arc_index);
+            arc_indexes_.erase(GetArcKey(neighbor, vertex));
+        }
+        for (const size_t arc_index : out_arcs_[vertex]) {
+            const VertexId neighbor = arcs_[arc_index].to;
+            ++contracted_neighbors_[neighbor];
+            remove_index(in_arcs_[neighbor], arc_index);
+            arc_indexes_.erase(GetArcKey(vertex, neighbor));
+        }
+        std::vector<size_t>().swap(in_arcs_[vertex]);
+        std::vector<size_t>().swap(out_arcs_[vertex]);
+    }
+
+    template <typename Weight>
+    void ContractionHierarchy<Weight>::Contractor::Run() {
+        const size_t vertex_count = graph_.GetVertexCount();
+        hierarchy_data_.ranks.assign(vertex_count, 0);
+        hierarchy_data_.shortcuts.clear();
+
+        // В очереди ровно по одной записи на каждую несжатую вершину
+        using QueueItem = std::pair<int, VertexId>;
+        std::vector<QueueItem> queue;
+        queue.reserve(vertex_count);
+        for (VertexId vertex = 0; vertex < vertex_count; ++vertex) {
+            queue.emplace_back(ComputePriority(vertex), vertex);
+        }
+        std::make_heap(queue.begin(), queue.end(), std::greater<QueueItem>{});
+
+        uint32_t rank = 0;
+        size_t postponed_in_row = 0;
+        while (!queue.empty()) {
+            std::pop_heap(queue.begin(), queue.end(), std::greater<QueueItem>{});
+            const VertexId vertex = queue.back().second;
+            queue.pop_back();
+
+            // Ленивое обновление: приоритет пересчитывается только при извлечении вершины,
+            // и если он стал больше следующего в очереди, вершина откладывается
+            const int priority = ComputePriority(vertex);
+            if (!queue.empty() && queue.front().first < priority && postponed_in_row < LAZY_UPDATE_LIMIT) {
+                queue.emplace_back(priority, vertex);
+                std::push_heap(queue.begin(), queue.end(), std::greater<QueueItem>{});
+                ++postponed_in_row;
+                continue;
+            }
+            postponed_in_row = 0;
+
+            ContractVertex(vertex, false);
+            hierarchy_data_.ranks[vertex] = rank++;
+            RemoveVertex(vertex);
+        }
+    }
+
+    template <typename Weight>
+    ContractionHierarchy<Weight>::ContractionHierarchy(const Graph& graph)
+        : graph_(graph)
+    {
+        Contractor(graph_, hierarchy_data_).Run();
+        BuildSearchGraphs();
+    }
+
+    template <typename Weight>
+    ContractionHierarchy<Weight>::ContractionHierarchy(const Graph& graph, HierarchyData&& hierarchy_data)
+        : graph_(graph)
+        , hierarchy_data_(std::move(hierarchy_data))
+    {
+        if (hierarchy_data_.ranks.size() != graph_.GetVertexCount()) {
+            throw std::invalid_argument("Contraction hierarchy doesn't match the graph");
+        }
+        const EdgeId edge_count = graph_.GetEdgeCount() + hierarchy_data_.shortcuts.size();
+        for (const Shortcut& shortcut : hierarchy_data_.shortcuts) {
+            if (shortcut.first_edge >= edge_count || shortcut.second_edge >= edge_count
+                || shortcut.from >= graph_.GetVertexCount() || shortcut.to >= graph_.GetVertexCount()) {
+                throw std::invalid_argument("Contraction hierarchy doesn't match the graph");
+            }
+        }
+        BuildSearchGraphs();
+    }
+
+    template <typename Weight>
+    const typename ContractionHierarchy<Weight>::HierarchyData& ContractionHierarchy<Weight>::GetHierarchyData() const {
+        return hierarchy_data_;
+    }
+
+    template <typename Weight>
+    template <typename Func>
+    void ContractionHierarchy<Weight>::ForEachUpwardArc(VertexId vertex, bool forward, Func func) const {
+        const SearchGraph& search_graph = forward ? forward_graph_ : backward_graph_;
+        for (size_t index = search_graph.offsets[vertex]; index < search_graph.offsets[vertex + 1]; ++index) {
+            func(search_graph.arcs[index].vertex, search_graph.arcs[index].weight);
+        }
+    }
+
+    template <typename Weight>
+    VertexId ContractionHierarchy<Weight>::GetEdgeFrom(EdgeId edge_id) const {
+        return edge_id < graph_.GetEdgeCount()
+            ? graph_.GetEdge(edge_id).from
+            : hierarchy_data_.shortcuts[edge_id - graph_.GetEdgeCount()].from;
+    }
+
+    template <typename Weight>
+    VertexId ContractionHierarchy<Weight>::GetEdgeTo(EdgeId edge_id) const {
+        return edge_id < graph_.GetEdgeCount()
+            ? graph_.GetEdge(edge_id).to
+            : hierarchy_data_.shortcuts[edge_id - graph_.GetEdgeCount()].to;
+    }
+
+    template <typename Weight>
+    void ContractionHierarchy<Weight>::BuildSearchGraphs() {
+        const size_t vertex_count = graph_.GetVertexCount();
+        const auto& ranks = hierarchy_data_.ranks;
+
+        // Все рёбра и сокращения раскладываются по двум графам поиска сортировкой подсчётом
+        auto for_each_edge = [this](const auto& func) {
+            for (EdgeId edge_id = 0; edge_id < graph_.GetEdgeCount(); ++edge_id) {
+                const auto& edge = graph_.GetEdge(edge_id);
+                func(edge.from, edge.to, edge.weight, edge_id);
+            }
+            for (size_t index = 0; index < hierarchy_data_.shortcuts.size(); ++index) {
+                const Shortcut& shortcut = hierarchy_data_.shortcuts[index];
+                func(shortcut.from, shortcut.to, shortcut.weight, graph_.GetEdgeCount() + index);
+            }
+        };
+
+        forward_graph_.offsets.assign(vertex_count + 1, 0);
+        backward_graph_.offsets.assign(vertex_count + 1, 0);
+        for_each_edge([&](VertexId from, VertexId to, Weight, EdgeId) {
+            if (from == to) {
+                return;
+            }
+            if (ranks[from] < ranks[to]) {
+                ++forward_graph_.offsets[from + 1];
+            }
+            else {
+                ++backward_graph_.offsets[to + 1];
+            }
+        });
+        for (VertexId vertex = 0; vertex < vertex_count; ++vertex) {
+            forward_graph_.offsets[vertex + 1] += forward_graph_.offsets[vertex];
+            backward_graph_.offsets[vertex + 1] += backward_graph_.offsets[vertex];
+        }
+
+        forward_graph_.arcs.resize(forward_graph_.offsets.back());
+        backward_graph_.arcs.resize(backward_graph_.offsets.back());
+        std::vector<size_t> forward_positions(forward_graph_.offsets.begin(), forward_graph_.offsets.end() - 1);
+        std::vector<size_t> backward_positions(backward_graph_.offsets.begin(), backward_graph_.offsets.end() - 1);
+        for_each_edge([&](VertexId from, VertexId to, Weight weight, EdgeId edge_id) {
+            if (from == to) {
+                return;
+            }
+            if (ranks[from] < ranks[to]) {
+                forward_graph_.arcs[forward_positions[from]++] = { to, weight, edge_id };
+            }
+            else {
+                backward_graph_.arcs[backward_positions[to]++] = { from, weight, edge_id };
+            }
+        });
+    }
+
+    template <typename Weight>
+    void ContractionHierarchy<Weight>::UnpackEdge(EdgeId edge_id, std::vector<EdgeId>& edges) const {
+        std::vector<EdgeId> stack{ edge_id };
+        while (!stack.empty()) {
+            const EdgeId current = stack.back();
+            stack.pop_back();
+            if (current < graph_.GetEdgeCount()) {
+                edges.push_back(current);
+            }
+            else {
+                const Shortcut& shortcut = hierarchy_data_.shortcuts[current - graph_.GetEdgeCount()];
+                stack.push_back(shortcut.second_edge);
+                stack.push_back(shortcut.first_edge);
+            }
+        }
+    }
+
+    template <typename Weight>
+    std::pair<typename ContractionHierarchy<Weight>::Workspace, typename ContractionHierarchy<Weight>::Workspace>&
+        ContractionHierarchy<Weight>::GetWorkspaces(size_t vertex_count) {
+        thread_local std::pair<Workspace, Workspace> workspaces;
+        workspaces.first.Prepare(vertex_count);
+        workspaces.second.Prepare(vertex_count);
+        return workspaces;
+    }
+
+    template <typename Weight>
+    void ContractionHierarchy<Weight>::SearchStep(Workspace& workspace, const Workspace& opposite, const SearchGraph& search_graph,
+        Weight& best_weight, VertexId& meeting_vertex) {
+        typename Workspace::HeapItem item;
+        if (!workspace.PopNearest(item)) {
+            return;
+        }
+        const auto [distance, vertex] = item;
+        // Вершина достигнута поиском с другой стороны - кандидат на точку встречи
+        if (opposite.distance[vertex] != Workspace::INFINITE_WEIGHT && distance + opposite.distance[vertex] < best_weight) {
+            best_weight = distance + opposite.distance[vertex];
+            meeting_vertex = vertex;
+        }
+        for (size_t index = search_graph.offsets[vertex]; index < search_graph.offsets[vertex + 1]; ++index) {
+            const Arc& arc = search_graph.arcs[index];
+            workspace.Update(arc.vertex, distance + arc.weight, arc.edge_id);
+        }
+    }
+
+    template <typename Weight>
+    std::optional<typename ContractionHierarchy<Weight>::RouteInfo> ContractionHierarchy<Weight>::BuildRoute(VertexId from,
+        VertexId to) const {
+        const size_t vertex_count = graph_.GetVertexCount();
+        if (from >= vertex_count || to >= vertex_count) {
+            throw std::out_of_range("Vertex is out of graph");
+        }
+
+        auto& [forward, backward] = GetWorkspaces(vertex_count);
+        forward.Update(from, ZERO_WEIGHT, Workspace::NO_EDGE);
+        backward.Update(to, ZERO_WEIGHT, Workspace::NO_EDGE);
+
+        Weight best_weight = Workspace::INFINITE_WEIGHT;
+        VertexId meeting_vertex = from;
+        // Поиск останавливается, когда ни одна из сторон уже не может улучшить найденный путь
+        while (true) {
+            const Weight forward_min = forward.GetMinQueued();
+            const Weight backward_min = backward.GetMinQueued();
+            if (!(std::min(forward_min, backward_min) < best_weight)) {
+                break;
+            }
+            if (forward_min <= backward_min) {
+                SearchStep(forward, backward, forward_graph_, best_weight, meeting_vertex);
+            }
+            else {
+                SearchStep(backward, forward, backward_graph_, best_weight, meeting_vertex);
+            }
+        }
+
+        std::optional<RouteInfo> result;
+        if (best_weight != Workspace::INFINITE_WEIGHT) {
+            // Рёбра от начала до точки встречи и от точки встречи до конца, включая сокращения
+            std::vector<EdgeId> packed_edges;
+            for (EdgeId edge_id = forward.prev_edge[meeting_vertex]; edge_id != Workspace::NO_EDGE;
+                edge_id = forward.prev_edge[GetEdgeFrom(edge_id)]) {
+                packed_edges.push_back(edge_id);
+            }
+            std::reverse(packed_edges.begin(), packed_edges.end());
+            for (EdgeId edge_id = backward.prev_edge[meeting_vertex]; edge_id != Workspace::NO_EDGE;
+                edge_id = backward.prev_edge[GetEdgeTo(edge_id)]) {
+                packed_edges.push_back(edge_id);
+            }
+
+            Weight weight = ZERO_WEIGHT;
+            std::vector<EdgeId> edges;
+            for (const EdgeId edge_id : packed_edges) {
+                UnpackEdge(edge_id, edges);
+            }
+            for (const EdgeId edge_id : edges) {
+                weight += graph_.GetEdge(edge_id).weight;
+            }
+            result = RouteInfo{ weight, std::move(edges) };
+        }
+
+        forward.Reset();
+        backward.Reset();
+        return result;
+    }
+
+}  // namespace graph
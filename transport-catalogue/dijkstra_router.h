@@ -0,0 +1,648 @@
+#pragma once
+
+#include "graph.h"
+#include "router.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace graph {
+
+    // Рабочие буферы поиска по графу: расстояния, последние рёбра путей и двоичная куча.
+    // Заводятся по одному на поток и переиспользуются между запросами,
+    // после поиска сбрасываются только затронутые вершины из списка touched
+    template <typename Weight>
+    struct SearchWorkspace {
+        static constexpr Weight INFINITE_WEIGHT = std::numeric_limits<Weight>::max();
+        static constexpr EdgeId NO_EDGE = std::numeric_limits<EdgeId>::max();
+
+        // Элемент кучи: ключ вершины (расстояние, либо его сумма с потенциалом при поиске A*) и сама вершина
+        using HeapItem = std::pair<Weight, VertexId>;
+
+        std::vector<Weight> distance;
+        std::vector<EdgeId> prev_edge;
+        // Потенциалы поиска A*, рассчитанные при первом обращении к вершине. INFINITE_WEIGHT - не рассчитан
+        std::vector<Weight> potential;
+        std::vector<VertexId> touched;
+        std::vector<HeapItem> heap;
+
+        void Prepare(size_t vertex_count);
+        void Reset();
+
+        // Улучшает расстояние до вершины, если candidate меньше текущего, и кладёт её в кучу
+        bool Update(VertexId vertex, Weight candidate, EdgeId edge_id);
+        // То же, но вершина кладётся в кучу с ключом candidate + potential
+        bool Update(VertexId vertex, Weight candidate, EdgeId edge_id, Weight potential);
+        // Извлекает из кучи ближайшую вершину, пропуская устаревшие записи. false - куча пуста
+        bool PopNearest(HeapItem& item);
+        // То же для ключей с потенциалом: potential(vertex) должен совпадать с переданным в Update
+        template <typename Potential>
+        bool PopNearest(HeapItem& item, const Potential& potential);
+        // Наименьший ключ среди записей кучи
+        Weight GetMinQueued() const;
+    };
+
+    // Класс, реализующий поиск кратчайшего пути алгоритмом Дейкстры в момент запроса.
+    // В отличие от Router не требует предварительного расчёта всех пар вершин:
+    // построение занимает O(E), память O(V + E).
+    template <typename Weight>
+    class DijkstraRouter {
+    private:
+        using Graph = DirectedWeightedGraph<Weight>;
+        using Workspace = SearchWorkspace<Weight>;
+
+    public:
+        explicit DijkstraRouter(const Graph& graph);
+
+        using RouteInfo = typename Router<Weight>::RouteInfo;
+
+        std::optional<RouteInfo> BuildRoute(VertexId from, VertexId to) const;
+        // Поиск A*: potential(vertex) - нижняя оценка веса пути от vertex до to.
+        // Оценка должна быть согласованной: potential(u) <= weight(u -> v) + potential(v) для любого ребра,
+        // тогда каждая вершина обрабатывается один раз и найденный путь кратчайший
+        template <typename Potential>
+        std::optional<RouteInfo> BuildRoute(VertexId from, VertexId to, const Potential& potential) const;
+
+        // До max_count путей из from в to без повторения вершин в порядке возрастания веса (алгоритм Йена).
+        // Ответвления ищутся от конца пути к from, поэтому оценки для них даёт обычный поиск от from до to.
+        // Пустой вектор - пути нет
+        std::vector<RouteInfo> BuildRoutes(VertexId from, VertexId to, size_t max_count) const;
+        // То же, но из путей, для которых is_same_route(edges, other_edges) истинно, остаётся только первый найденный,
+        // а пути, для которых is_allowed_route(edges) ложно, не выдаются. От таких путей всё равно ищутся ответвления,
+        // поэтому допустимые пути, отличающиеся от них, не теряются
+        template <typename IsSameRoute, typename IsAllowedRoute>
+        std::vector<RouteInfo> BuildRoutes(VertexId from, VertexId to, size_t max_count,
+            const IsSameRoute& is_same_route, const IsAllowedRoute& is_allowed_route) const;
+
+        // Веса кратчайших путей из from до каждой из вершин targets одним поиском,
+        // который останавливается, как только обработаны все targets. nullopt - пути нет
+        std::vector<std::optional<Weight>> ComputeWeights(VertexId from, const std::vector<VertexId>& targets) const;
+
+        // Все вершины, достижимые из from путём весом не больше max_weight, и веса этих путей
+        // в порядке возрастания. Поиск не продолжается за пределом max_weight
+        std::vector<std::pair<VertexId, Weight>> ComputeReachable(VertexId from, Weight max_weight) const;
+
+    private:
+        static constexpr Weight ZERO_WEIGHT{};
+
+        const Graph& graph_;
+
+        // Входящие рёбра вершин в том же виде, что и исходящие в графе: начала рёбер в targets.
+        // Нужны только для поиска до вершины, поэтому строятся при первом таком поиске
+        struct ReverseArcs {
+            std::vector<size_t> offsets;
+            std::vector<uint32_t> edge_ids;
+            std::vector<uint32_t> sources;
+            std::vector<Weight> weights;
+        };
+        mutable std::once_flag reverse_arcs_flag_;
+        mutable ReverseArcs reverse_arcs_;
+
+        // Путь алгоритма Йена рёбрами от to к from: номер ребра, с которого он отклонился от пути, из которого получен
+        // (ответвления раньше него уже искались для того пути с тем же корнем - улучшение Лоулера),
+        // и признак пути, который не выдаётся: повтора уже найденного маршрута или недопустимого пути
+        struct YenPath {
+            RouteInfo route;
+            size_t deviation;
+            bool hidden;
+        };
+
+        // Номер в candidates последнего из needed нужных выдаваемых кандидатов, либо candidates.size()
+        static size_t FindLastNeeded(const std::vector<YenPath>& candidates, size_t needed);
+        // Добавляет кандидата с сохранением порядка по весу, если такого же пути среди кандидатов нет,
+        // и отбрасывает кандидатов после последнего нужного
+        template <typename IsSameRoute, typename IsAllowedRoute>
+        static void AddCandidate(std::vector<YenPath>& candidates, YenPath&& candidate, const std::vector<YenPath>& paths,
+            size_t needed, const IsSameRoute& is_same_route, const IsAllowedRoute& is_allowed_route);
+
+        // Рабочие буферы поиска. source - буферы поиска от начала пути для оценок, которые нужны одновременно с основными
+        static Workspace& GetWorkspace(size_t vertex_count, bool source = false);
+        // Поиск до to с ключами кучи distance + potential(vertex). potential вызывается только для вершин,
+        // расстояние до которых улучшено, поэтому все они попадают в touched
+        template <typename Potential>
+        std::optional<RouteInfo> SearchRoute(Workspace& workspace, VertexId from, VertexId to,
+            const Potential& potential) const;
+        // Путь до to по найденным в workspace последним рёбрам путей. Сбрасывает workspace.
+        // backward - поиск шёл по входящим рёбрам, тогда рёбра пути идут от начала поиска к to против направления
+        std::optional<RouteInfo> ExtractRoute(Workspace& workspace, VertexId to, bool backward = false) const;
+
+        IncidentArcs<Weight> GetIncomingArcs(VertexId vertex) const;
+        // Поиск от from в source_workspace: расстояния от from и последние рёбра путей от from.
+        // Останавливается, как только обработана вершина to
+        void ComputeSourceDistances(Workspace& source_workspace, VertexId from, VertexId to) const;
+        // Нижняя оценка расстояния от from до vertex по незавершённому поиску от from: расстояние для обработанных
+        // вершин, наименьший ключ кучи для остальных. Оценка согласованная. INFINITE_WEIGHT - пути от from нет
+        static Weight GetSourcePotential(const Workspace& source_workspace, Weight radius, VertexId vertex);
+        // Кратчайший путь from -> spur_vertex весом не больше max_weight, не проходящий через вершины blocked_vertexes
+        // и не заканчивающийся рёбрами blocked_edges: ответвление пути в алгоритме Йена. Ищется по входящим рёбрам
+        // от spur_vertex, рёбра пути идут от spur_vertex. Расстояния от from без запретов по поиску в source_workspace -
+        // нижняя оценка поиска A*
+        std::optional<RouteInfo> BuildSpurRoute(VertexId spur_vertex, VertexId from, const std::vector<uint8_t>& blocked_vertexes,
+            const std::vector<EdgeId>& blocked_edges, Weight max_weight, const Workspace& source_workspace) const;
+    };
+
+    template <typename Weight>
+    void SearchWorkspace<Weight>::Prepare(size_t vertex_count) {
+        if (distance.size() < vertex_count) {
+            distance.resize(vertex_count, INFINITE_WEIGHT);
+            prev_edge.resize(vertex_count, NO_EDGE);
+            potential.resize(vertex_count, INFINITE_WEIGHT);
+        }
+    }
+
+    template <typename Weight>
+    void SearchWorkspace<Weight>::Reset() {
+        for (const VertexId vertex : touched) {
+            distance[vertex] = INFINITE_WEIGHT;
+            prev_edge[vertex] = NO_EDGE;
+            potential[vertex] = INFINITE_WEIGHT;
+        }
+        touched.clear();
+        heap.clear();
+    }
+
+    template <typename Weight>
+    bool SearchWorkspace<Weight>::Update(VertexId vertex, Weight candidate, EdgeId edge_id) {
+        return Update(vertex, candidate, edge_id, Weight{});
+    }
+
+    template <typename Weight>
+    bool SearchWorkspace<Weight>::Update(VertexId vertex, Weight candidate, EdgeId edge_id, Weight potential) {
+        Weight& current = distance[vertex];
+        if (!(candidate < current)) {
+            return false;
+        }
+        if (current == INFINITE_WEIGHT) {
+            touched.push_back(vertex);
+        }
+        current = candidate;
+        prev_edge[vertex] = edge_id;
+        heap.emplace_back(candidate + potential, vertex);
+        std::push_heap(heap.begin(), heap.end(), std::greater<HeapItem>{});
+        return true;
+    }
+
+    template <typename Weight>
+    bool SearchWorkspace<Weight>::PopNearest(HeapItem& item) {
+        return PopNearest(item, [](VertexId) { return Weight{}; });
+    }
+
+    template <typename Weight>
+    template <typename Potential>
+    bool SearchWorkspace<Weight>::PopNearest(HeapItem& item, const Potential& potential) {
+        while (!heap.empty()) {
+            std::pop_heap(heap.begin(), heap.end(), std::greater<HeapItem>{});
+            item = heap.back();
+            heap.pop_back();
+            // Устаревшая запись в куче, вершина уже обработана с меньшим расстоянием
+            if (!(distance[item.second] + potential(item.second) < item.first)) {
+                // Возвращаем расстояние до вершины, а не ключ
+                item.first = distance[item.second];
+                return true;
+            }
+        }
+        return false;
+    }
+
+    template <typename Weight>
+    Weight SearchWorkspace<Weight>::GetMinQueued() const {
+        return heap.empty() ? INFINITE_WEIGHT : heap.front().first;
+    }
+
+    template <typename Weight>
+    DijkstraRouter<Weight>::DijkstraRouter(const Graph& graph)
+        : graph_(graph)
+    {
+        if (!graph_.IsFrozen()) {
+            throw std::logic_error("Graph should be frozen before routing");
+        }
+        for (const auto& edge : graph_.GetEdges()) {
+            if (edge.weight < ZERO_WEIGHT) {
+                throw std::domain_error("Edges' weights should be non-negative");
+            }
+        }
+    }
+
+    template <typename Weight>
+    typename DijkstraRouter<Weight>::Workspace& DijkstraRouter<Weight>::GetWorkspace(size_t vertex_count, bool source) {
+        thread_local Workspace workspace;
+        thread_local Workspace source_workspace;
+        Workspace& result = source ? source_workspace : workspace;
+        result.Prepare(vertex_count);
+        return result;
+    }
+
+    template <typename Weight>
+    IncidentArcs<Weight> DijkstraRouter<Weight>::GetIncomingArcs(VertexId vertex) const {
+        std::call_once(reverse_arcs_flag_, [this]() {
+            // Раскладка рёбер по концам подсчётом
+            const size_t vertex_count = graph_.GetVertexCount();
+            const auto& edges = graph_.GetEdges();
+            reverse_arcs_.offsets.assign(vertex_count + 1, 0);
+            for (const auto& edge : edges) {
+                ++reverse_arcs_.offsets[edge.to + 1];
+            }
+            for (size_t index = 0; index < vertex_count; ++index) {
+                reverse_arcs_.offsets[index + 1] += reverse_arcs_.offsets[index];
+            }
+            std::vector<size_t> next_positions(reverse_arcs_.offsets.begin(), reverse_arcs_.offsets.end() - 1);
+            reverse_arcs_.edge_ids.resize(edges.size());
+            reverse_arcs_.sources.resize(edges.size());
+            reverse_arcs_.weights.resize(edges.size());
+            for (EdgeId edge_id = 0; edge_id < edges.size(); ++edge_id) {
+                const size_t position = next_positions[edges[edge_id].to]++;
+                reverse_arcs_.edge_ids[position] = static_cast<uint32_t>(edge_id);
+                reverse_arcs_.sources[position] = static_cast<uint32_t>(edges[edge_id].from);
+                reverse_arcs_.weights[position] = edges[edge_id].weight;
+            }
+        });
+        const size_t begin = reverse_arcs_.offsets[vertex];
+        return { reverse_arcs_.edge_ids.data() + begin, reverse_arcs_.sources.data() + begin,
+            reverse_arcs_.weights.data() + begin, reverse_arcs_.offsets[vertex + 1] - begin };
+    }
+
+    template <typename Weight>
+    void DijkstraRouter<Weight>::ComputeSourceDistances(Workspace& source_workspace, VertexId from, VertexId to) const {
+        source_workspace.Update(from, ZERO_WEIGHT, Workspace::NO_EDGE);
+        typename Workspace::HeapItem item;
+        while (source_workspace.PopNearest(item)) {
+            const auto [distance, vertex] = item;
+            const IncidentArcs<Weight> arcs = graph_.GetIncidentArcs(vertex);
+            for (size_t i = 0; i < arcs.count; ++i) {
+                source_workspace.Update(arcs.targets[i], distance + arcs.weights[i], arcs.edge_ids[i]);
+            }
+            if (vertex == to) {
+                break;
+            }
+        }
+    }
+
+    template <typename Weight>
+    Weight DijkstraRouter<Weight>::GetSourcePotential(const Workspace& source_workspace, Weight radius, VertexId vertex) {
+        // Ключи кучи не меньше расстояний обработанных вершин и не больше расстояний необработанных
+        return std::min(source_workspace.distance[vertex], radius);
+    }
+
+    template <typename Weight>
+    std::optional<typename DijkstraRouter<Weight>::RouteInfo> DijkstraRouter<Weight>::BuildRoute(VertexId from,
+        VertexId to) const {
+        const size_t vertex_count = graph_.GetVertexCount();
+        if (from >= vertex_count || to >= vertex_count) {
+            throw std::out_of_range("Vertex is out of graph");
+        }
+        return SearchRoute(GetWorkspace(vertex_count), from, to, [](VertexId) { return ZERO_WEIGHT; });
+    }
+
+    template <typename Weight>
+    template <typename Potential>
+    std::optional<typename DijkstraRouter<Weight>::RouteInfo> DijkstraRouter<Weight>::BuildRoute(VertexId from,
+        VertexId to, const Potential& potential) const {
+        const size_t vertex_count = graph_.GetVertexCount();
+        if (from >= vertex_count || to >= vertex_count) {
+            throw std::out_of_range("Vertex is out of graph");
+        }
+
+        // Оценка считается один раз на вершину и только для вершин, до которых дошёл поиск
+        Workspace& workspace = GetWorkspace(vertex_count);
+        return SearchRoute(workspace, from, to, [&workspace, &potential](VertexId vertex) {
+            Weight& cached = workspace.potential[vertex];
+            if (cached == Workspace::INFINITE_WEIGHT) {
+                cached = potential(vertex);
+            }
+            return cached;
+        });
+    }
+
+    template <typename Weight>
+    template <typename Potential>
+    std::optional<typename DijkstraRouter<Weight>::RouteInfo> DijkstraRouter<Weight>::SearchRoute(Workspace& workspace,
+        VertexId from, VertexId to, const Potential& potential) const {
+        workspace.Update(from, ZERO_WEIGHT, Workspace::NO_EDGE, potential(from));
+
+        typename Workspace::HeapItem item;
+        while (workspace.PopNearest(item, potential)) {
+            const auto [distance, vertex] = item;
+            if (vertex == to) {
+                break;
+            }
+            const IncidentArcs<Weight> arcs = graph_.GetIncidentArcs(vertex);
+            for (size_t i = 0; i < arcs.count; ++i) {
+                const Weight candidate = distance + arcs.weights[i];
+                if (candidate < workspace.distance[arcs.targets[i]]) {
+                    workspace.Update(arcs.targets[i], candidate, arcs.edge_ids[i], potential(arcs.targets[i]));
+                }
+            }
+        }
+
+        return ExtractRoute(workspace, to);
+    }
+
+    template <typename Weight>
+    std::optional<typename DijkstraRouter<Weight>::RouteInfo> DijkstraRouter<Weight>::ExtractRoute(Workspace& workspace,
+        VertexId to, bool backward) const {
+        std::optional<RouteInfo> result;
+        if (workspace.distance[to] != Workspace::INFINITE_WEIGHT) {
+            std::vector<EdgeId> edges;
+            for (EdgeId edge_id = workspace.prev_edge[to]; edge_id != Workspace::NO_EDGE;
+                edge_id = workspace.prev_edge[backward ? graph_.GetEdge(edge_id).to : graph_.GetEdge(edge_id).from])
+            {
+                edges.push_back(edge_id);
+            }
+            std::reverse(edges.begin(), edges.end());
+            result = RouteInfo{ workspace.distance[to], std::move(edges) };
+        }
+
+        workspace.Reset();
+        return result;
+    }
+
+    template <typename Weight>
+    std::optional<typename DijkstraRouter<Weight>::RouteInfo> DijkstraRouter<Weight>::BuildSpurRoute(VertexId spur_vertex,
+        VertexId from, const std::vector<uint8_t>& blocked_vertexes, const std::vector<EdgeId>& blocked_edges,
+        Weight max_weight, const Workspace& source_workspace) const {
+        const Weight radius = source_workspace.GetMinQueued();
+        auto potential = [&source_workspace, radius](VertexId vertex) {
+            return GetSourcePotential(source_workspace, radius, vertex);
+        };
+
+        Workspace& workspace = GetWorkspace(graph_.GetVertexCount());
+        workspace.Update(spur_vertex, ZERO_WEIGHT, Workspace::NO_EDGE, potential(spur_vertex));
+
+        typename Workspace::HeapItem item;
+        while (workspace.PopNearest(item, potential)) {
+            const auto [distance, vertex] = item;
+            if (vertex == from) {
+                break;
+            }
+            const IncidentArcs<Weight> arcs = GetIncomingArcs(vertex);
+            for (size_t i = 0; i < arcs.count; ++i) {
+                const VertexId target = arcs.targets[i];
+                const Weight target_potential = potential(target);
+                // В вершины без пути от from и через запрещённые вершины и рёбра не идём
+                if (target_potential == Workspace::INFINITE_WEIGHT || blocked_vertexes[target] || (vertex == spur_vertex
+                    && std::find(blocked_edges.begin(), blocked_edges.end(), arcs.edge_ids[i]) != blocked_edges.end())) {
+                    continue;
+                }
+                const Weight candidate = distance + arcs.weights[i];
+                // Путь через target не легче candidate + target_potential
+                if (!(max_weight < candidate + target_potential)) {
+                    workspace.Update(target, candidate, arcs.edge_ids[i], target_potential);
+                }
+            }
+        }
+
+        return ExtractRoute(workspace, from, true);
+    }
+
+    template <typename Weight>
+    size_t DijkstraRouter<Weight>::FindLastNeeded(const std::vector<YenPath>& candidates, size_t needed) {
+        size_t index = 0;
+        for (; index < candidates.size(); ++index) {
+            if (!candidates[index].hidden && --needed == 0) {
+                break;
+            }
+        }
+        return index;
+    }
+
+    template <typename Weight>
+    template <typename IsSameRoute, typename IsAllowedRoute>
+    void DijkstraRouter<Weight>::AddCandidate(std::vector<YenPath>& candidates, YenPath&& candidate,
+        const std::vector<YenPath>& paths, size_t needed, const IsSameRoute& is_same_route,
+        const IsAllowedRoute& is_allowed_route) {
+        if (std::any_of(candidates.begin(), candidates.end(), [&candidate](const YenPath& other) {
+            return other.route.edges == candidate.route.edges;
+        })) {
+            return;
+        }
+        auto is_same = [&candidate, &is_same_route](const YenPath& other) {
+            return !other.hidden && is_same_route(other.route.edges, candidate.route.edges);
+        };
+        candidate.hidden = !is_allowed_route(candidate.route.edges)
+            || std::any_of(paths.begin(), paths.end(), is_same)
+            || std::any_of(candidates.begin(), candidates.end(), is_same);
+
+        const auto position = std::upper_bound(candidates.begin(), candidates.end(), candidate.route.weight,
+            [](Weight weight, const YenPath& other) { return weight < other.route.weight; });
+        candidates.insert(position, std::move(candidate));
+        const size_t last_needed = FindLastNeeded(candidates, needed);
+        if (last_needed < candidates.size()) {
+            candidates.erase(candidates.begin() + last_needed + 1, candidates.end());
+        }
+    }
+
+    template <typename Weight>
+    std::vector<typename DijkstraRouter<Weight>::RouteInfo> DijkstraRouter<Weight>::BuildRoutes(VertexId from,
+        VertexId to, size_t max_count) const {
+        return BuildRoutes(from, to, max_count,
+            [](const std::vector<EdgeId>&, const std::vector<EdgeId>&) { return false; },
+            [](const std::vector<EdgeId>&) { return true; });
+    }
+
+    template <typename Weight>
+    template <typename IsSameRoute, typename IsAllowedRoute>
+    std::vector<typename DijkstraRouter<Weight>::RouteInfo> DijkstraRouter<Weight>::BuildRoutes(VertexId from,
+        VertexId to, size_t max_count, const IsSameRoute& is_same_route, const IsAllowedRoute& is_allowed_route) const {
+        const size_t vertex_count = graph_.GetVertexCount();
+        if (from >= vertex_count || to >= vertex_count) {
+            throw std::out_of_range("Vertex is out of graph");
+        }
+        std::vector<RouteInfo> result;
+        if (max_count == 0) {
+            return result;
+        }
+        if (max_count == 1) {
+            // Альтернативы не нужны: хранить поиск для оценок незачем, если кратчайший путь допустим
+            auto route = BuildRoute(from, to);
+            if (!route) {
+                return result;
+            }
+            if (is_allowed_route(route->edges)) {
+                result.push_back(std::move(*route));
+                return result;
+            }
+        }
+
+        // Поиск от from даёт кратчайший путь и нижние оценки для поиска всех ответвлений, поэтому ответвления
+        // ищутся к from, а корень - общий конец путей. Поиск от from при этом тот же, что и для одного пути:
+        // в транспортном графе он и просматривает меньше вершин, чем поиск до to, потому что посадка стоит
+        // ожидания автобуса, а высадка бесплатна. Дальше кратчайшего пути поиск не продолжается: при наибольшем
+        // весе из его кучи оценки грубее, но уточнение их до веса нужных кандидатов обходится дороже ответвлений
+        Workspace& source_workspace = GetWorkspace(vertex_count, true);
+        ComputeSourceDistances(source_workspace, from, to);
+        if (source_workspace.distance[to] == Workspace::INFINITE_WEIGHT) {
+            source_workspace.Reset();
+            return result;
+        }
+        RouteInfo shortest{ source_workspace.distance[to], {} };
+        for (VertexId vertex = to; vertex != from; vertex = graph_.GetEdge(shortest.edges.back()).from) {
+            shortest.edges.push_back(source_workspace.prev_edge[vertex]);
+        }
+
+        // Проверки путей получают рёбра в порядке от from к to
+        auto is_same = [&is_same_route](const std::vector<EdgeId>& lhs, const std::vector<EdgeId>& rhs) {
+            return is_same_route(std::vector<EdgeId>(lhs.rbegin(), lhs.rend()), std::vector<EdgeId>(rhs.rbegin(), rhs.rend()));
+        };
+        auto is_allowed = [&is_allowed_route](const std::vector<EdgeId>& edges) {
+            return is_allowed_route(std::vector<EdgeId>(edges.rbegin(), edges.rend()));
+        };
+
+        // Найденные пути, в том числе повторяющие уже найденный маршрут: от них тоже ищутся ответвления,
+        // иначе пропадут пути, отличающиеся от повтора не только тем, что делает его повтором
+        std::vector<YenPath> paths;
+        const bool is_shortest_hidden = !is_allowed(shortest.edges);
+        paths.push_back({ std::move(shortest), 0, is_shortest_hidden });
+        size_t route_count = is_shortest_hidden ? 0 : 1;
+        // Кандидаты в следующие пути по возрастанию веса. Хранятся только кандидаты не тяжелее
+        // последнего из нужных неповторяющихся: остальные заведомо не понадобятся
+        std::vector<YenPath> candidates;
+        std::vector<uint8_t> blocked_vertexes(vertex_count, 0);
+        std::vector<EdgeId> blocked_edges;
+
+        while (route_count < max_count) {
+            const YenPath& last = paths.back();
+            const std::vector<EdgeId>& last_edges = last.route.edges;
+            const size_t needed = max_count - route_count;
+            // Корень - общий конец пути от вершины ответвления, его вершины для ответвления запрещены
+            Weight root_weight = ZERO_WEIGHT;
+            for (size_t index = 0; index < last_edges.size(); ++index) {
+                const Edge<Weight>& spur_edge = graph_.GetEdge(last_edges[index]);
+                if (index >= last.deviation) {
+                    // Худший из нужных кандидатов ограничивает вес ответвления. Корни дальше только тяжелее
+                    const size_t last_needed = FindLastNeeded(candidates, needed);
+                    const Weight bound = last_needed == candidates.size()
+                        ? Workspace::INFINITE_WEIGHT
+                        : candidates[last_needed].route.weight;
+                    if (!(root_weight < bound)) {
+                        break;
+                    }
+
+                    // Ответвление не должно повторять предыдущее ребро ни одного найденного пути с тем же корнем
+                    blocked_edges.clear();
+                    for (const YenPath& path : paths) {
+                        if (path.route.edges.size() > index
+                            && std::equal(last_edges.begin(), last_edges.begin() + index, path.route.edges.begin())) {
+                            blocked_edges.push_back(path.route.edges[index]);
+                        }
+                    }
+
+                    auto spur = BuildSpurRoute(spur_edge.to, from, blocked_vertexes, blocked_edges,
+                        bound == Workspace::INFINITE_WEIGHT ? bound : bound - root_weight, source_workspace);
+                    if (spur && root_weight + spur->weight < bound) {
+                        YenPath candidate{
+                            { root_weight + spur->weight, std::vector<EdgeId>(last_edges.begin(), last_edges.begin() + index) },
+                            index,
+                            false
+                        };
+                        candidate.route.edges.insert(candidate.route.edges.end(), spur->edges.begin(), spur->edges.end());
+                        AddCandidate(candidates, std::move(candidate), paths, needed, is_same, is_allowed);
+                    }
+                }
+                blocked_vertexes[spur_edge.to] = 1;
+                root_weight += spur_edge.weight;
+            }
+            for (const EdgeId edge_id : last_edges) {
+                blocked_vertexes[graph_.GetEdge(edge_id).to] = 0;
+            }
+
+            if (candidates.empty()) {
+                break;
+            }
+            route_count += candidates.front().hidden ? 0 : 1;
+            paths.push_back(std::move(candidates.front()));
+            candidates.erase(candidates.begin());
+        }
+
+        source_workspace.Reset();
+        for (YenPath& path : paths) {
+            if (!path.hidden) {
+                std::reverse(path.route.edges.begin(), path.route.edges.end());
+                result.push_back(std::move(path.route));
+            }
+        }
+        return result;
+    }
+
+    template <typename Weight>
+    std::vector<std::optional<Weight>> DijkstraRouter<Weight>::ComputeWeights(VertexId from,
+        const std::vector<VertexId>& targets) const {
+        const size_t vertex_count = graph_.GetVertexCount();
+        if (from >= vertex_count) {
+            throw std::out_of_range("Vertex is out of graph");
+        }
+        std::vector<VertexId> unique_targets = targets;
+        std::sort(unique_targets.begin(), unique_targets.end());
+        unique_targets.erase(std::unique(unique_targets.begin(), unique_targets.end()), unique_targets.end());
+        if (!unique_targets.empty() && unique_targets.back() >= vertex_count) {
+            throw std::out_of_range("Vertex is out of graph");
+        }
+
+        Workspace& workspace = GetWorkspace(vertex_count);
+        workspace.Update(from, ZERO_WEIGHT, Workspace::NO_EDGE);
+
+        size_t targets_left = unique_targets.size();
+        typename Workspace::HeapItem item;
+        while (targets_left > 0 && workspace.PopNearest(item)) {
+            const auto [distance, vertex] = item;
+            if (std::binary_search(unique_targets.begin(), unique_targets.end(), vertex)) {
+                --targets_left;
+            }
+            const IncidentArcs<Weight> arcs = graph_.GetIncidentArcs(vertex);
+            for (size_t i = 0; i < arcs.count; ++i) {
+                workspace.Update(arcs.targets[i], distance + arcs.weights[i], arcs.edge_ids[i]);
+            }
+        }
+
+        std::vector<std::optional<Weight>> result;
+        result.reserve(targets.size());
+        for (const VertexId target : targets) {
+            if (workspace.distance[target] != Workspace::INFINITE_WEIGHT) {
+                result.emplace_back(workspace.distance[target]);
+            }
+            else {
+                result.emplace_back(std::nullopt);
+            }
+        }
+
+        workspace.Reset();
+        return result;
+    }
+
+    template <typename Weight>
+    std::vector<std::pair<VertexId, Weight>> DijkstraRouter<Weight>::ComputeReachable(VertexId from,
+        Weight max_weight) const {
+        const size_t vertex_count = graph_.GetVertexCount();
+        if (from >= vertex_count) {
+            throw std::out_of_range("Vertex is out of graph");
+        }
+
+        Workspace& workspace = GetWorkspace(vertex_count);
+        workspace.Update(from, ZERO_WEIGHT, Workspace::NO_EDGE);
+
+        std::vector<std::pair<VertexId, Weight>> result;
+        typename Workspace::HeapItem item;
+        while (workspace.PopNearest(item)) {
+            const auto [distance, vertex] = item;
+            result.emplace_back(vertex, distance);
+            const IncidentArcs<Weight> arcs = graph_.GetIncidentArcs(vertex);
+            for (size_t i = 0; i < arcs.count; ++i) {
+                const Weight candidate = distance + arcs.weights[i];
+                // Вершины за пределом не попадают в кучу, поэтому поиск сам заканчивается на границе
+                if (!(max_weight < candidate)) {
+                    workspace.Update(arcs.targets[i], candidate, arcs.edge_ids[i]);
+                }
+            }
+        }
+
+        workspace.Reset();
+        return result;
+    }
+
+}  // namespace graph
@@ -25,18 +25,24 @@ namespace domain {
 
 	//    
 	struct Stop {
-		std::string stop_name_ = "";
+		//    NameArena 
+		std::string_view stop_name_;
 		geo::Coordinates stop_coordinates_;
+		//     ,  0  - 
+		size_t id_ = 0;
 	};
 
 	//    
 	struct Bus {
-		std::string bus_name_ = "";
+		//    NameArena 
+		std::string_view bus_name_;
 		std::vector<const Stop*> stops_;
 		bool is_circular_ = false;
 		size_t unique_stops_ = 0;
 		double length_real_ = 0;
 		double length_geo_ = 0;
+		//     ,  0  - 
+		size_t id_ = 0;
 	};
 
 	//        
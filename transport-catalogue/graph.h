@@ -3,7 +3,10 @@
 #include "ranges.h"
 #include "domain.h"
 
+#include <cstdint>
 #include <cstdlib>
+#include <limits>
+#include <stdexcept>
 #include <vector>
 
 namespace graph {
@@ -11,65 +14,214 @@ namespace graph {
     using VertexId = size_t;
     using EdgeId = size_t;
 
-    //     - 
-    using EdgeBusInfo = std::pair<std::string_view, int>;
-    using EdgeInfo = std::optional<EdgeBusInfo>;
+    // .   :  , -      .
+    //    ,      
+    struct EdgeInfo {
+        //   ,     
+        static constexpr uint32_t NO_BUS = std::numeric_limits<uint32_t>::max();
+
+        uint32_t bus_id = NO_BUS;
+        uint32_t span_count = 0;
+        uint32_t distance = 0;
+
+        bool HasBus() const {
+            return bus_id != NO_BUS;
+        }
+    };
 
     template <typename Weight>
     struct Edge {
         VertexId from;
         VertexId to;
         Weight weight;
-        // .   
-        EdgeInfo info;
     };
 
-    // ,    ,
+    // и,     : id,    i- .
+    //  ,         Edge
+    template <typename Weight>
+    struct IncidentArcs {
+        const uint32_t* edge_ids;
+        const uint32_t* targets;
+        const Weight* weights;
+        size_t count;
+    };
+
+    // ,    .
+    //   ,      .  Freeze()  
+    //    (CSR):        id,    
     template <typename Weight>
     class DirectedWeightedGraph {
     private:
-        using IncidenceList = std::vector<EdgeId>;
+        using IncidenceList = std::vector<uint32_t>;
         using IncidentEdgesRange = ranges::Range<typename IncidenceList::const_iterator>;
 
     public:
         DirectedWeightedGraph() = default;
         //      
         explicit DirectedWeightedGraph(size_t vertex_count);
-        //  
-        EdgeId AddEdge(const Edge<Weight>& edge);
+        //  .    
+        EdgeId AddEdge(const Edge<Weight>& edge, EdgeInfo info = {});
+
+        //  CSR         
+        //     .        
+        void Freeze();
+        bool IsFrozen() const;
+        //      func(edge_id, edge_info).    ,
+        //        
+        template <typename Func>
+        void Reweight(Func func);
+        //  :  v   new_ids[v]. и   
+        //   ,     .   Freeze()
+        void PermuteVertexes(const std::vector<VertexId>& new_ids);
 
         size_t GetVertexCount() const;
         size_t GetEdgeCount() const;
         const Edge<Weight>& GetEdge(EdgeId edge_id) const;
+        const EdgeInfo& GetEdgeInfo(EdgeId edge_id) const;
         IncidentEdgesRange GetIncidentEdges(VertexId vertex) const;
+        //    
+        IncidentArcs<Weight> GetIncidentArcs(VertexId vertex) const;
 
         const std::vector<Edge<Weight>>& GetEdges() const;
-        const std::vector<IncidenceList>& GetVertexes() const;
-
+        const std::vector<EdgeInfo>& GetEdgeInfos() const;
+        //      Freeze(), i-  GetEdgeInfos()   i- 
         std::vector<Edge<Weight>>& GetEdges();
-        std::vector<IncidenceList>& GetVertexes();
+        std::vector<EdgeInfo>& GetEdgeInfos();
+
+        //  ,     ,  
+        size_t GetMemoryUsage() const;
     private:
-        //  
+        size_t vertex_count_ = 0;
+        //    .     id 
         std::vector<Edge<Weight>> edges_;
+        std::vector<EdgeInfo> edge_infos_;
         std::vector<IncidenceList> incidence_lists_;
+
+        bool is_frozen_ = false;
+        // и  v   [offsets_[v], offsets_[v + 1])  arc_*.
+        //    32 ,       16    
+        std::vector<size_t> offsets_;
+        std::vector<uint32_t> arc_edge_ids_;
+        std::vector<uint32_t> arc_targets_;
+        std::vector<Weight> arc_weights_;
     };
 
     template <typename Weight>
     DirectedWeightedGraph<Weight>::DirectedWeightedGraph(size_t vertex_count)
-        : incidence_lists_(vertex_count) {
+        : vertex_count_(vertex_count)
+        , incidence_lists_(vertex_count) {
     }
 
     template <typename Weight>
-    EdgeId DirectedWeightedGraph<Weight>::AddEdge(const Edge<Weight>& edge) {
+    EdgeId DirectedWeightedGraph<Weight>::AddEdge(const Edge<Weight>& edge, EdgeInfo info) {
+        if (is_frozen_) {
+            throw std::logic_error("Graph is frozen");
+        }
         edges_.push_back(edge);
+        edge_infos_.push_back(info);
         const EdgeId id = edges_.size() - 1;
-        incidence_lists_.at(edge.from).push_back(id);
+        incidence_lists_.at(edge.from).push_back(static_cast<uint32_t>(id));
         return id;
     }
 
+    template <typename Weight>
+    void DirectedWeightedGraph<Weight>::Freeze() {
+        if (is_frozen_) {
+            return;
+        }
+        if (vertex_count_ > std::numeric_limits<uint32_t>::max() || edges_.size() > std::numeric_limits<uint32_t>::max()) {
+            throw std::length_error("Too many vertices or edges for the frozen graph");
+        }
+        if (edge_infos_.size() != edges_.size()) {
+            throw std::logic_error("Edge infos don't match the edges");
+        }
+        offsets_.assign(vertex_count_ + 1, 0);
+        for (const auto& edge : edges_) {
+            if (edge.from >= vertex_count_ || edge.to >= vertex_count_) {
+                throw std::out_of_range("Edge vertex is out of graph");
+            }
+            ++offsets_[edge.from + 1];
+        }
+        for (VertexId vertex = 0; vertex < vertex_count_; ++vertex) {
+            offsets_[vertex + 1] += offsets_[vertex];
+        }
+
+        arc_edge_ids_.resize(edges_.size());
+        arc_targets_.resize(edges_.size());
+        arc_weights_.resize(edges_.size());
+        std::vector<size_t> positions(offsets_.begin(), offsets_.end() - 1);
+        for (EdgeId edge_id = 0; edge_id < edges_.size(); ++edge_id) {
+            const auto& edge = edges_[edge_id];
+            const size_t position = positions[edge.from]++;
+            arc_edge_ids_[position] = static_cast<uint32_t>(edge_id);
+            arc_targets_[position] = static_cast<uint32_t>(edge.to);
+            arc_weights_[position] = edge.weight;
+        }
+
+        std::vector<IncidenceList>().swap(incidence_lists_);
+        is_frozen_ = true;
+    }
+
+    template <typename Weight>
+    template <typename Func>
+    void DirectedWeightedGraph<Weight>::Reweight(Func func) {
+        for (EdgeId edge_id = 0; edge_id < edges_.size(); ++edge_id) {
+            edges_[edge_id].weight = func(edge_id, edge_infos_[edge_id]);
+        }
+        for (size_t position = 0; position < arc_weights_.size(); ++position) {
+            arc_weights_[position] = edges_[arc_edge_ids_[position]].weight;
+        }
+    }
+
+    template <typename Weight>
+    void DirectedWeightedGraph<Weight>::PermuteVertexes(const std::vector<VertexId>& new_ids) {
+        if (is_frozen_) {
+            throw std::logic_error("Graph is frozen");
+        }
+        if (new_ids.size() != vertex_count_) {
+            throw std::invalid_argument("Vertex permutation doesn't match the graph");
+        }
+        std::vector<uint8_t> is_taken(vertex_count_, 0);
+        for (const VertexId new_id : new_ids) {
+            if (new_id >= vertex_count_ || is_taken[new_id]) {
+                throw std::invalid_argument("Vertex permutation is inconsistent");
+            }
+            is_taken[new_id] = 1;
+        }
+
+        //    :     ,   
+        std::vector<IncidenceList> incidence_lists(vertex_count_);
+        for (VertexId vertex = 0; vertex < vertex_count_; ++vertex) {
+            incidence_lists[new_ids[vertex]] = std::move(incidence_lists_[vertex]);
+        }
+
+        // и    ,       
+        std::vector<Edge<Weight>> edges;
+        std::vector<EdgeInfo> edge_infos;
+        edges.reserve(edges_.size());
+        edge_infos.reserve(edge_infos_.size());
+        for (IncidenceList& incidence_list : incidence_lists) {
+            for (uint32_t& edge_id : incidence_list) {
+                const Edge<Weight>& edge = edges_[edge_id];
+                edges.push_back({ new_ids[edge.from], new_ids[edge.to], edge.weight });
+                edge_infos.push_back(edge_infos_[edge_id]);
+                edge_id = static_cast<uint32_t>(edges.size() - 1);
+            }
+        }
+
+        edges_ = std::move(edges);
+        edge_infos_ = std::move(edge_infos);
+        incidence_lists_ = std::move(incidence_lists);
+    }
+
+    template <typename Weight>
+    bool DirectedWeightedGraph<Weight>::IsFrozen() const {
+        return is_frozen_;
+    }
+
     template <typename Weight>
     size_t DirectedWeightedGraph<Weight>::GetVertexCount() const {
-        return incidence_lists_.size();
+        return vertex_count_;
     }
 
     template <typename Weight>
@@ -82,21 +234,35 @@ namespace graph {
         return edges_.at(edge_id);
     }
 
+    template <typename Weight>
+    const EdgeInfo& DirectedWeightedGraph<Weight>::GetEdgeInfo(EdgeId edge_id) const {
+        return edge_infos_.at(edge_id);
+    }
+
     template <typename Weight>
     typename DirectedWeightedGraph<Weight>::IncidentEdgesRange
         DirectedWeightedGraph<Weight>::GetIncidentEdges(VertexId vertex) const {
+        if (is_frozen_) {
+            return { arc_edge_ids_.begin() + offsets_.at(vertex), arc_edge_ids_.begin() + offsets_.at(vertex + 1) };
+        }
         return ranges::AsRange(incidence_lists_.at(vertex));
     }
 
+    template <typename Weight>
+    IncidentArcs<Weight> DirectedWeightedGraph<Weight>::GetIncidentArcs(VertexId vertex) const {
+        const size_t begin = offsets_[vertex];
+        return { arc_edge_ids_.data() + begin, arc_targets_.data() + begin, arc_weights_.data() + begin,
+            offsets_[vertex + 1] - begin };
+    }
+
     template <typename Weight>
     const std::vector<Edge<Weight>>& DirectedWeightedGraph<Weight>::GetEdges() const {
         return edges_;        
     }
 
-    template <typename Weight>    
-    const typename std::vector<typename DirectedWeightedGraph<Weight>::IncidenceList>&
-        DirectedWeightedGraph<Weight>::GetVertexes() const {
-        return incidence_lists_;
+    template <typename Weight>
+    const std::vector<EdgeInfo>& DirectedWeightedGraph<Weight>::GetEdgeInfos() const {
+        return edge_infos_;
     }
 
     template <typename Weight>
@@ -105,8 +271,21 @@ namespace graph {
     }
 
     template <typename Weight>
-    typename std::vector<typename DirectedWeightedGraph<Weight>::IncidenceList>&
-        DirectedWeightedGraph<Weight>::GetVertexes() {
-        return incidence_lists_;
+    std::vector<EdgeInfo>& DirectedWeightedGraph<Weight>::GetEdgeInfos() {
+        return edge_infos_;
+    }
+
+    template <typename Weight>
+    size_t DirectedWeightedGraph<Weight>::GetMemoryUsage() const {
+        size_t bytes = edges_.capacity() * sizeof(Edge<Weight>)
+            + edge_infos_.capacity() * sizeof(EdgeInfo)
+            + offsets_.capacity() * sizeof(size_t)
+            + arc_edge_ids_.capacity() * sizeof(uint32_t)
+            + arc_targets_.capacity() * sizeof(uint32_t)
+            + arc_weights_.capacity() * sizeof(Weight);
+        for (const auto& incidence_list : incidence_lists_) {
+            bytes += sizeof(incidence_list) + incidence_list.capacity() * sizeof(uint32_t);
+        }
+        return bytes;
     }
 }  // namespace graph
\ No newline at end of file
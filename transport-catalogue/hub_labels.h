@@ -0,0 +1,244 @@
+#pragma once
+
+#include "graph.h"
+#include "contraction_hierarchy.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace graph {
+
+    // Метки хабов (Hub Labeling) для расчёта времени кратчайшего пути без поиска по графу.
+    // У каждой вершины v есть прямая метка - вершины-хабы h с расстоянием v -> h, и обратная -
+    // хабы с расстоянием h -> v. Кратчайший путь from -> to проходит через общий хаб прямой метки from
+    // и обратной метки to, поэтому запрос - слияние двух отсортированных по хабу массивов.
+    // Метки строятся по иерархии сжатия: хабы вершины - вершины её поиска "вверх" по иерархии
+    template <typename Weight>
+    class HubLabels {
+    public:
+        // Метки всех вершин одного направления подряд: метка вершины v - элементы
+        // с offsets[v] по offsets[v + 1] - 1 массивов hubs и distances, отсортированные по хабу
+        struct Labels {
+            std::vector<size_t> offsets;
+            std::vector<uint32_t> hubs;
+            std::vector<Weight> distances;
+        };
+
+        struct LabelsData {
+            Labels forward;
+            Labels backward;
+        };
+
+        explicit HubLabels(const ContractionHierarchy<Weight>& hierarchy);
+        // Создаёт оракул по ранее построенным меткам
+        explicit HubLabels(LabelsData&& labels_data);
+
+        // Вес кратчайшего пути from -> to, nullopt - пути нет
+        std::optional<Weight> ComputeWeight(VertexId from, VertexId to) const;
+
+        const LabelsData& GetLabelsData() const;
+        size_t GetVertexCount() const;
+        // Общее кол-во элементов прямых и обратных меток
+        size_t GetLabelEntryCount() const;
+        size_t GetMemoryUsage() const;
+
+    private:
+        static constexpr Weight ZERO_WEIGHT{};
+        static constexpr Weight INFINITE_WEIGHT = std::numeric_limits<Weight>::max();
+
+        using LabelEntry = std::pair<uint32_t, Weight>;
+
+        LabelsData labels_data_;
+
+        static void ValidateLabels(const Labels& labels);
+        // Минимум distance + opposite_distance по общим хабам двух меток
+        static Weight MergeLabels(const Labels& labels, VertexId vertex, const Labels& opposite, VertexId opposite_vertex);
+        static Labels FlattenLabels(std::vector<std::vector<LabelEntry>>& labels);
+    };
+
+    template <typename Weight>
+    HubLabels<Weight>::HubLabels(const ContractionHierarchy<Weight>& hierarchy) {
+        const std::vector<uint32_t>& ranks = hierarchy.GetHierarchyData().ranks;
+        const size_t vertex_count = ranks.size();
+
+        // Метки строятся сверху вниз: к моменту обработки вершины метки всех вершин выше неё готовы
+        std::vector<VertexId> order(vertex_count);
+        std::iota(order.begin(), order.end(), 0);
+        std::sort(order.begin(), order.end(), [&ranks](VertexId lhs, VertexId rhs) {
+            return ranks[lhs] > ranks[rhs];
+        });
+
+        std::vector<std::vector<LabelEntry>> forward_labels(vertex_count);
+        std::vector<std::vector<LabelEntry>> backward_labels(vertex_count);
+        // Расстояния до хабов строящейся метки и список затронутых хабов для быстрого сброса
+        std::vector<Weight> candidate(vertex_count, INFINITE_WEIGHT);
+        std::vector<VertexId> touched;
+
+        for (const VertexId vertex : order) {
+            for (const bool forward : { true, false }) {
+                auto& labels = forward ? forward_labels : backward_labels;
+                const auto& opposite_labels = forward ? backward_labels : forward_labels;
+
+                // Кандидаты: сама вершина и хабы вершин, в которые ведут дуги "вверх", с весом дуги
+                candidate[vertex] = ZERO_WEIGHT;
+                touched.push_back(vertex);
+                hierarchy.ForEachUpwardArc(vertex, forward, [&](VertexId upper, Weight weight) {
+                    for (const auto& [hub, distance] : labels[upper]) {
+                        if (candidate[hub] == INFINITE_WEIGHT) {
+                            touched.push_back(hub);
+                        }
+                        candidate[hub] = std::min(candidate[hub], weight + distance);
+                    }
+                });
+
+                // Хаб оставляем, только если через другие хабы до него не добраться быстрее:
+                // иначе расстояние в метке не кратчайшее и хаб не нужен ни одному запросу
+                std::vector<LabelEntry>& label = labels[vertex];
+                for (const VertexId hub : touched) {
+                    bool dominated = false;
+                    if (hub != vertex) {
+                        for (const auto& [opposite_hub, distance] : opposite_labels[hub]) {
+                            if (opposite_hub != hub && candidate[opposite_hub] != INFINITE_WEIGHT
+                                && candidate[opposite_hub] + distance < candidate[hub]) {
+                                dominated = true;
+                                break;
+                            }
+                        }
+                    }
+                    if (!dominated) {
+                        label.emplace_back(static_cast<uint32_t>(hub), candidate[hub]);
+                    }
+                }
+                std::sort(label.begin(), label.end());
+                label.shrink_to_fit();
+
+                for (const VertexId hub : touched) {
+                    candidate[hub] = INFINITE_WEIGHT;
+                }
+                touched.clear();
+            }
+        }
+
+        labels_data_.forward = FlattenLabels(forward_labels);
+        labels_data_.backward = FlattenLabels(backward_labels);
+    }
+
+    template <typename Weight>
+    HubLabels<Weight>::HubLabels(LabelsData&& labels_data)
+        : labels_data_(std::move(labels_data))
+    {
+        ValidateLabels(labels_data_.forward);
+        ValidateLabels(labels_data_.backward);
+        if (labels_data_.forward.offsets.size() != labels_data_.backward.offsets.size()) {
+            throw std::invalid_argument("Hub labels are inconsistent");
+        }
+    }
+
+    template <typename Weight>
+    void HubLabels<Weight>::ValidateLabels(const Labels& labels) {
+        const size_t vertex_count = labels.offsets.empty() ? 0 : labels.offsets.size() - 1;
+        if (labels.offsets.empty() || labels.offsets.front() != 0 || labels.offsets.back() != labels.hubs.size()
+            || labels.hubs.size() != labels.distances.size()
+            || !std::is_sorted(labels.offsets.begin(), labels.offsets.end())) {
+            throw std::invalid_argument("Hub labels are inconsistent");
+        }
+        for (size_t index = 0; index < labels.hubs.size(); ++index) {
+            if (labels.hubs[index] >= vertex_count) {
+                throw std::invalid_argument("Hub labels are inconsistent");
+            }
+        }
+    }
+
+    template <typename Weight>
+    typename HubLabels<Weight>::Labels HubLabels<Weight>::FlattenLabels(std::vector<std::vector<LabelEntry>>& labels) {
+        Labels result;
+        result.offsets.reserve(labels.size() + 1);
+        result.offsets.push_back(0);
+        for (const auto& label : labels) {
+            result.offsets.push_back(result.offsets.back() + label.size());
+        }
+        result.hubs.reserve(result.offsets.back());
+        result.distances.reserve(result.offsets.back());
+        for (auto& label : labels) {
+            for (const auto& [hub, distance] : label) {
+                result.hubs.push_back(hub);
+                result.distances.push_back(distance);
+            }
+            // Освобождаем память сразу, чтобы не держать метки дважды
+            std::vector<LabelEntry>().swap(label);
+        }
+        return result;
+    }
+
+    template <typename Weight>
+    Weight HubLabels<Weight>::MergeLabels(const Labels& labels, VertexId vertex, const Labels& opposite,
+        VertexId opposite_vertex) {
+        size_t index = labels.offsets[vertex];
+        const size_t end = labels.offsets[vertex + 1];
+        size_t opposite_index = opposite.offsets[opposite_vertex];
+        const size_t opposite_end = opposite.offsets[opposite_vertex + 1];
+
+        Weight best_weight = INFINITE_WEIGHT;
+        while (index < end && opposite_index < opposite_end) {
+            const uint32_t hub = labels.hubs[index];
+            const uint32_t opposite_hub = opposite.hubs[opposite_index];
+            if (hub == opposite_hub) {
+                best_weight = std::min(best_weight, labels.distances[index] + opposite.distances[opposite_index]);
+                ++index;
+                ++opposite_index;
+            }
+            else if (hub < opposite_hub) {
+                ++index;
+            }
+            else {
+                ++opposite_index;
+            }
+        }
+        return best_weight;
+    }
+
+    template <typename Weight>
+    std::optional<Weight> HubLabels<Weight>::ComputeWeight(VertexId from, VertexId to) const {
+        if (from >= GetVertexCount() || to >= GetVertexCount()) {
+            throw std::out_of_range("Vertex is out of graph");
+        }
+        const Weight weight = MergeLabels(labels_data_.forward, from, labels_data_.backward, to);
+        if (weight == INFINITE_WEIGHT) {
+            return std::nullopt;
+        }
+        return weight;
+    }
+
+    template <typename Weight>
+    const typename HubLabels<Weight>::LabelsData& HubLabels<Weight>::GetLabelsData() const {
+        return labels_data_;
+    }
+
+    template <typename Weight>
+    size_t HubLabels<Weight>::GetVertexCount() const {
+        return labels_data_.forward.offsets.size() - 1;
+    }
+
+    template <typename Weight>
+    size_t HubLabels<Weight>::GetLabelEntryCount() const {
+        return labels_data_.forward.hubs.size() + labels_data_.backward.hubs.size();
+    }
+
+    template <typename Weight>
+    size_t HubLabels<Weight>::GetMemoryUsage() const {
+        size_t bytes = 0;
+        for (const Labels* labels : { &labels_data_.forward, &labels_data_.backward }) {
+            bytes += labels->offsets.capacity() * sizeof(size_t)
+                + labels->hubs.capacity() * sizeof(uint32_t)
+                + labels->distances.capacity() * sizeof(Weight);
+        }
+        return bytes;
+    }
+
+}  // namespace graph
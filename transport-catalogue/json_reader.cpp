@@ -26,8 +26,16 @@ namespace JSONReader {
 		: request_id_(request_id) {
 	}
 
-	RouteOutputRequest::RouteOutputRequest(int request_id, std::string_view from, std::string_view to)
-		: request_id_(request_id), from_(from), to_(to) {
+	RouteOutputRequest::RouteOutputRequest(int request_id, std::string_view from, std::string_view to, bool time_only)
+		: request_id_(request_id), from_(from), to_(to), time_only_(time_only) {
+	}
+
+	MatrixOutputRequest::MatrixOutputRequest(int request_id, std::vector<std::string_view> from, std::vector<std::string_view> to)
+		: request_id_(request_id), from_(std::move(from)), to_(std::move(to)) {
+	}
+
+	ReachableOutputRequest::ReachableOutputRequest(int request_id, std::string_view from, double max_time)
+		: request_id_(request_id), from_(from), max_time_(max_time) {
 	}
 
 	// --------------------------------------------------
@@ -125,10 +133,53 @@ namespace JSONReader {
 			}
 			//    
 			else if (request.AsDict().at("type").AsString() == "Route") {	
-				output_requests.push_back(RouteOutputRequest(
+				// time_only   :       ,   
+				const bool time_only = request.AsDict().count("time_only") && request.AsDict().at("time_only").AsBool();
+				RouteOutputRequest route_request(
 					request.AsDict().at("id").AsInt(),
 					request.AsDict().at("from").AsString(),
-					request.AsDict().at("to").AsString()
+					request.AsDict().at("to").AsString(),
+					time_only
+				);
+				// pareto   :     -    ,
+				// max_extra_time   ,         
+				route_request.pareto_ = request.AsDict().count("pareto") && request.AsDict().at("pareto").AsBool();
+				if (request.AsDict().count("max_extra_time")) {
+					route_request.max_extra_time_ = request.AsDict().at("max_extra_time").AsDouble();
+				}
+				// alternatives   -     :   
+				if (request.AsDict().count("alternatives")) {
+					const int alternatives = request.AsDict().at("alternatives").AsInt();
+					if (alternatives < 1) {
+						throw std::invalid_argument("alternatives must be positive");
+					}
+					route_request.alternatives_ = static_cast<size_t>(alternatives);
+				}
+				output_requests.push_back(std::move(route_request));
+			}
+			//      
+			else if (request.AsDict().at("type").AsString() == "Matrix") {
+				std::vector<std::string_view> from;
+				for (const json::Node& stop : request.AsDict().at("from").AsArray()) {
+					from.push_back(stop.AsString());
+				}
+				std::vector<std::string_view> to;
+				for (const json::Node& stop : request.AsDict().at("to").AsArray()) {
+					to.push_back(stop.AsString());
+				}
+
+				output_requests.push_back(MatrixOutputRequest(
+					request.AsDict().at("id").AsInt(),
+					std::move(from),
+					std::move(to)
+				));
+			}
+			//   ,    
+			else if (request.AsDict().at("type").AsString() == "Reachable") {
+				output_requests.push_back(ReachableOutputRequest(
+					request.AsDict().at("id").AsInt(),
+					request.AsDict().at("from").AsString(),
+					request.AsDict().at("max_time").AsDouble()
 				));
 			}
 		}
@@ -194,10 +245,91 @@ namespace JSONReader {
 		const json::Dict& routing_settings = json_data_->GetRoot().AsDict().at("routing_settings").AsDict();
 		// bus_wait_time      ,  		
 		// bus_velocity   ,  /
-		return { 
+		router::TransportRouterSettings settings{
 			routing_settings.at("bus_wait_time").AsInt(),
 			routing_settings.at("bus_velocity").AsInt()
 		};
+		// router_type     : "dijkstra" ( ), "all_pairs", "ch", "a_star"  "raptor"
+		if (routing_settings.count("router_type")) {
+			const std::string& router_type = routing_settings.at("router_type").AsString();
+			if (router_type == "all_pairs") {
+				settings.router_type_ = router::RouterType::ALL_PAIRS;
+			}
+			else if (router_type == "ch") {
+				settings.router_type_ = router::RouterType::CONTRACTION_HIERARCHIES;
+			}
+			else if (router_type == "a_star") {
+				settings.router_type_ = router::RouterType::A_STAR;
+			}
+			else if (router_type == "raptor") {
+				settings.router_type_ = router::RouterType::RAPTOR;
+			}
+			else if (router_type == "dijkstra") {
+				settings.router_type_ = router::RouterType::DIJKSTRA;
+			}
+			else {
+				throw std::invalid_argument("Unknown router_type: " + router_type);
+			}
+		}
+
+		// graph_model    : "complete" ( )  "linear"
+		if (routing_settings.count("graph_model")) {
+			const std::string& graph_model = routing_settings.at("graph_model").AsString();
+			if (graph_model == "linear") {
+				settings.graph_model_ = router::GraphModel::LINEAR;
+			}
+			else if (graph_model == "complete") {
+				settings.graph_model_ = router::GraphModel::COMPLETE;
+			}
+			else {
+				throw std::invalid_argument("Unknown graph_model: " + graph_model);
+			}
+		}
+		// vertex_order     : "creation" ( )  "rcm"
+		if (routing_settings.count("vertex_order")) {
+			const std::string& vertex_order = routing_settings.at("vertex_order").AsString();
+			if (vertex_order == "rcm") {
+				settings.vertex_order_ = router::VertexOrder::REVERSE_CUTHILL_MCKEE;
+			}
+			else if (vertex_order == "creation") {
+				settings.vertex_order_ = router::VertexOrder::CREATION;
+			}
+			else {
+				throw std::invalid_argument("Unknown vertex_order: " + vertex_order);
+			}
+		}
+		// memory_report        
+		if (routing_settings.count("memory_report")) {
+			settings.memory_report_ = routing_settings.at("memory_report").AsBool();
+		}
+		// route_cache_capacity      ,    
+		if (routing_settings.count("route_cache_capacity")) {
+			const int route_cache_capacity = routing_settings.at("route_cache_capacity").AsInt();
+			if (route_cache_capacity < 0) {
+				throw std::invalid_argument("route_cache_capacity must be non-negative");
+			}
+			settings.route_cache_capacity_ = static_cast<size_t>(route_cache_capacity);
+		}
+		// hub_labels            
+		if (routing_settings.count("hub_labels")) {
+			settings.hub_labels_ = routing_settings.at("hub_labels").AsBool();
+		}
+
+		return settings;
+	}
+
+	void JSONLoader::ParseRoutingMetric(router::TransportRouterSettings& settings) {
+		const json::Dict& root = json_data_->GetRoot().AsDict();
+		if (!root.count("routing_settings")) {
+			return;
+		}
+		const json::Dict& routing_settings = root.at("routing_settings").AsDict();
+		if (routing_settings.count("bus_wait_time")) {
+			settings.bus_wait_time_ = routing_settings.at("bus_wait_time").AsInt();
+		}
+		if (routing_settings.count("bus_velocity")) {
+			settings.bus_velocity_ = routing_settings.at("bus_velocity").AsInt();
+		}
 	}
 
 	SerializationSettings JSONLoader::ParseSerializationSettings() {
@@ -6,6 +6,7 @@
 #include "transport_router.h"
 
 #include <vector>
+#include <optional>
 #include <variant>
 #include <string_view>
 #include <algorithm>
@@ -64,11 +65,19 @@ namespace JSONReader {
 
 	//       ,   id
 	struct RouteOutputRequest {
-		RouteOutputRequest(int request_id, std::string_view from, std::string_view to);
+		RouteOutputRequest(int request_id, std::string_view from, std::string_view to, bool time_only = false);
 
 		int request_id_;
 		std::string_view from_;
 		std::string_view to_;
+		//     ,   
+		bool time_only_;
+		//   ,         - 
+		bool pareto_ = false;
+		//  pareto_:       ,  
+		std::optional<double> max_extra_time_;
+		//   :   . 0 -  ,    
+		size_t alternatives_ = 0;
 	};
 
 	//       
@@ -78,8 +87,29 @@ namespace JSONReader {
 		int request_id_;
 	};
 
+	//           
+	//  id       
+	struct MatrixOutputRequest {
+		MatrixOutputRequest(int request_id, std::vector<std::string_view> from, std::vector<std::string_view> to);
+
+		int request_id_;
+		std::vector<std::string_view> from_;
+		std::vector<std::string_view> to_;
+	};
+
+	//       ,    
+	//  id ,       
+	struct ReachableOutputRequest {
+		ReachableOutputRequest(int request_id, std::string_view from, double max_time);
+
+		int request_id_;
+		std::string_view from_;
+		double max_time_;
+	};
+
 	using InputRequest = std::variant<StopInputRequest, StopToStopDistanceInputRequest, BusInputRequest>;
-	using OutputRequest = std::variant<StopOutputRequest, BusOutputRequest, MapOutputRequest, RouteOutputRequest>;
+	using OutputRequest = std::variant<StopOutputRequest, BusOutputRequest, MapOutputRequest, RouteOutputRequest,
+		MatrixOutputRequest, ReachableOutputRequest>;
 
 	using InputRequestPool = std::vector<InputRequest>;
 	using OutputRequestPool = std::vector<OutputRequest>;
@@ -110,6 +140,9 @@ namespace JSONReader {
 
 		//    transport_router
 		router::TransportRouterSettings ParseRouterSettings();
+		//       settings   routing_settings,   .
+		//       make_base
+		void ParseRoutingMetric(router::TransportRouterSettings& settings);
 
 		//   
 		SerializationSettings ParseSerializationSettings();
@@ -0,0 +1,137 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <list>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace cache {
+
+	struct CacheStats {
+		size_t hits = 0;
+		size_t misses = 0;
+		size_t size = 0;
+		size_t capacity = 0;
+	};
+
+	// Потокобезопасный кэш с вытеснением давно неиспользованных записей (LRU).
+	// Записи распределены по сегментам по хэшу ключа, у каждого сегмента свой мьютекс,
+	// поэтому запросы к разным сегментам не блокируют друг друга
+	template <typename Key, typename Value, typename Hash = std::hash<Key>>
+	class ShardedLruCache {
+	public:
+		// capacity - общее кол-во записей, делится между сегментами поровну с точностью до одной записи. При capacity == 0 кэш выключен
+		explicit ShardedLruCache(size_t capacity, size_t shard_count = DEFAULT_SHARD_COUNT);
+
+		ShardedLruCache(const ShardedLruCache&) = delete;
+		ShardedLruCache& operator=(const ShardedLruCache&) = delete;
+
+		bool IsEnabled() const;
+
+		// Возвращает копию значения и помечает запись как использованную последней
+		std::optional<Value> Get(const Key& key);
+		// Добавляет или заменяет запись, вытесняя самую давно использованную при переполнении сегмента
+		void Put(const Key& key, Value value);
+
+		CacheStats GetStats() const;
+
+	private:
+		static constexpr size_t DEFAULT_SHARD_COUNT = 16;
+
+		struct Shard {
+			mutable std::mutex mutex;
+			// Кол-во записей сегмента. Сумма по сегментам равна общей вместимости кэша
+			size_t capacity = 0;
+			// Записи от использованной последней к самой давней
+			std::list<std::pair<Key, Value>> entries;
+			std::unordered_map<Key, typename std::list<std::pair<Key, Value>>::iterator, Hash> index;
+		};
+
+		size_t capacity_;
+		std::vector<Shard> shards_;
+		Hash hasher_;
+		std::atomic<size_t> hits_{ 0 };
+		std::atomic<size_t> misses_{ 0 };
+
+		Shard& GetShard(const Key& key);
+	};
+
+	template <typename Key, typename Value, typename Hash>
+	ShardedLruCache<Key, Value, Hash>::ShardedLruCache(size_t capacity, size_t shard_count)
+		: capacity_(capacity)
+		, shards_(capacity == 0 ? 0 : std::min(shard_count, capacity)) {
+		// Остаток от деления достаётся первым сегментам по одной записи
+		for (size_t index = 0; index < shards_.size(); ++index) {
+			shards_[index].capacity = capacity / shards_.size() + (index < capacity % shards_.size() ? 1 : 0);
+		}
+	}
+
+	template <typename Key, typename Value, typename Hash>
+	bool ShardedLruCache<Key, Value, Hash>::IsEnabled() const {
+		return !shards_.empty();
+	}
+
+	template <typename Key, typename Value, typename Hash>
+	typename ShardedLruCache<Key, Value, Hash>::Shard& ShardedLruCache<Key, Value, Hash>::GetShard(const Key& key) {
+		// Старшие биты хэша, чтобы выбор сегмента не совпадал с выбором корзины внутри unordered_map
+		const size_t hash = hasher_(key);
+		return shards_[(hash ^ (hash >> 32)) % shards_.size()];
+	}
+
+	template <typename Key, typename Value, typename Hash>
+	std::optional<Value> ShardedLruCache<Key, Value, Hash>::Get(const Key& key) {
+		if (!IsEnabled()) {
+			return std::nullopt;
+		}
+		Shard& shard = GetShard(key);
+		std::lock_guard guard(shard.mutex);
+		const auto it = shard.index.find(key);
+		if (it == shard.index.end()) {
+			++misses_;
+			return std::nullopt;
+		}
+		++hits_;
+		shard.entries.splice(shard.entries.begin(), shard.entries, it->second);
+		return it->second->second;
+	}
+
+	template <typename Key, typename Value, typename Hash>
+	void ShardedLruCache<Key, Value, Hash>::Put(const Key& key, Value value) {
+		if (!IsEnabled()) {
+			return;
+		}
+		Shard& shard = GetShard(key);
+		std::lock_guard guard(shard.mutex);
+		const auto it = shard.index.find(key);
+		if (it != shard.index.end()) {
+			it->second->second = std::move(value);
+			shard.entries.splice(shard.entries.begin(), shard.entries, it->second);
+			return;
+		}
+		if (shard.entries.size() >= shard.capacity) {
+			shard.index.erase(shard.entries.back().first);
+			shard.entries.pop_back();
+		}
+		shard.entries.emplace_front(key, std::move(value));
+		shard.index.emplace(key, shard.entries.begin());
+	}
+
+	template <typename Key, typename Value, typename Hash>
+	CacheStats ShardedLruCache<Key, Value, Hash>::GetStats() const {
+		CacheStats stats;
+		stats.hits = hits_;
+		stats.misses = misses_;
+		stats.capacity = capacity_;
+		for (const Shard& shard : shards_) {
+			std::lock_guard guard(shard.mutex);
+			stats.size += shard.entries.size();
+		}
+		return stats;
+	}
+
+} // namespace cache
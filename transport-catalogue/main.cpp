@@ -16,6 +16,9 @@ void PrintUsage(std::ostream& stream = std::cerr) {
 int main(int argc, char* argv[]) {
     //----------------------
     // tests::test0();
+    // tests::test1();
+    // tests::test2();
+    // tests::test3();
     // std::cout << "Test OK!" << std::endl;
     //---------------------------
     if (argc != 2) {
@@ -0,0 +1,40 @@
+#include "name_arena.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace Catalogue {
+
+	std::string_view NameArena::Add(std::string_view name) {
+		if (name.empty()) {
+			return {};
+		}
+		if (name.size() > free_size_) {
+			// Длинное имя получает собственный блок, чтобы не терять свободное место текущего
+			if (name.size() > next_block_size_ / 4) {
+				char* block = AllocateBlock(name.size());
+				std::memcpy(block, name.data(), name.size());
+				return { block, name.size() };
+			}
+			free_begin_ = AllocateBlock(next_block_size_);
+			free_size_ = next_block_size_;
+			next_block_size_ = std::min(next_block_size_ * 2, MAX_BLOCK_SIZE);
+		}
+		std::memcpy(free_begin_, name.data(), name.size());
+		const std::string_view stored_name(free_begin_, name.size());
+		free_begin_ += name.size();
+		free_size_ -= name.size();
+		return stored_name;
+	}
+
+	size_t NameArena::GetMemoryUsage() const {
+		return blocks_size_ + blocks_.capacity() * sizeof(std::unique_ptr<char[]>);
+	}
+
+	char* NameArena::AllocateBlock(size_t size) {
+		blocks_.push_back(std::make_unique<char[]>(size));
+		blocks_size_ += size;
+		return blocks_.back().get();
+	}
+
+}
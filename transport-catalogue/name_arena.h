@@ -0,0 +1,45 @@
+#pragma once
+
+#include <memory>
+#include <string_view>
+#include <vector>
+
+namespace Catalogue {
+
+	// Хранилище имён остановок и маршрутов. Символы имён дописываются в блоки, которые не перемещаются
+	// и не освобождаются до удаления хранилища, поэтому string_view на имена остаются действительными,
+	// а на имя не приходится отдельного выделения памяти. Поиск по имени хранилище не ведёт:
+	// для этого у справочника есть свои индексы
+	class NameArena {
+	public:
+		NameArena() = default;
+		// Копия ссылалась бы на блоки исходного хранилища
+		NameArena(const NameArena&) = delete;
+		NameArena& operator=(const NameArena&) = delete;
+		NameArena(NameArena&&) = default;
+		NameArena& operator=(NameArena&&) = default;
+
+		// Копирует name в хранилище и возвращает представление копии. Действительно, пока существует хранилище
+		std::string_view Add(std::string_view name);
+
+		// Объём памяти, занимаемой блоками и вектором указателей на них, в байтах
+		size_t GetMemoryUsage() const;
+
+	private:
+		// Первый блок небольшой, чтобы маленький справочник не занимал лишнего, каждый следующий вдвое больше
+		static constexpr size_t FIRST_BLOCK_SIZE = 1024;
+		static constexpr size_t MAX_BLOCK_SIZE = 64 * 1024;
+
+		std::vector<std::unique_ptr<char[]>> blocks_;
+		// Размер следующего блока и суммарный размер выделенных блоков
+		size_t next_block_size_ = FIRST_BLOCK_SIZE;
+		size_t blocks_size_ = 0;
+		// Свободная часть текущего блока
+		char* free_begin_ = nullptr;
+		size_t free_size_ = 0;
+
+		// Выделяет блок размера size и возвращает указатель на его начало
+		char* AllocateBlock(size_t size);
+	};
+
+}
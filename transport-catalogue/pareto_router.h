@@ -0,0 +1,198 @@
+#pragma once
+
+#include "graph.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <stdexcept>
+#include <tuple>
+#include <vector>
+
+namespace graph {
+
+    // Поиск путей по двум критериям: весу и кол-ву "учитываемых" рёбер (например, ожиданий автобуса).
+    // Результат - множество Парето: пути, ни один из которых не лучше другого по обоим критериям сразу.
+    // Метки поиска извлекаются в порядке (вес, кол-во рёбер), поэтому метка вершины не доминируется
+    // уже обработанными, только если у неё меньше учитываемых рёбер, чем у каждой из них: проверка - O(1)
+    template <typename Weight>
+    class ParetoRouter {
+    private:
+        using Graph = DirectedWeightedGraph<Weight>;
+
+    public:
+        static constexpr Weight INFINITE_WEIGHT = std::numeric_limits<Weight>::max();
+
+        struct RouteInfo {
+            Weight weight;
+            // Кол-во учитываемых рёбер пути
+            uint32_t counted_edges;
+            std::vector<EdgeId> edges;
+        };
+
+        // is_counted(edge_id) - учитывается ли ребро вторым критерием. Только для замороженного графа
+        template <typename IsCounted>
+        ParetoRouter(const Graph& graph, IsCounted is_counted);
+
+        // Пути множества Парето из from в to в порядке возрастания веса (и убывания кол-ва учитываемых рёбер).
+        // Пути тяжелее самого лёгкого более чем на max_extra_weight не ищутся. Пустой вектор - пути нет
+        std::vector<RouteInfo> BuildRoutes(VertexId from, VertexId to, Weight max_extra_weight = INFINITE_WEIGHT) const;
+
+    private:
+        static constexpr Weight ZERO_WEIGHT{};
+        static constexpr uint32_t NO_LABEL = std::numeric_limits<uint32_t>::max();
+        static constexpr uint32_t NO_COUNT = std::numeric_limits<uint32_t>::max();
+
+        // Метка - путь до вершины: ссылается на метку предыдущей вершины пути по индексу в пуле
+        struct Label {
+            Weight weight;
+            uint32_t counted_edges;
+            uint32_t vertex;
+            uint32_t parent;
+            uint32_t edge_id;
+        };
+
+        // Пул меток и буферы поиска. Заводятся по одному на поток и очищаются между запросами
+        // без освобождения памяти, поэтому после первых запросов поиск не выделяет память
+        struct Workspace {
+            // Элемент кучи: вес и кол-во учитываемых рёбер метки, индекс метки в пуле
+            using HeapItem = std::tuple<Weight, uint32_t, uint32_t>;
+
+            std::vector<Label> arena;
+            std::vector<HeapItem> heap;
+            // Наименьшее кол-во учитываемых рёбер среди обработанных меток вершины
+            std::vector<uint32_t> best_counts;
+            std::vector<uint32_t> touched;
+
+            void Prepare(size_t vertex_count);
+            void Reset();
+            void Push(const Label& label);
+        };
+
+        const Graph& graph_;
+        std::vector<uint8_t> counted_;
+
+        static Workspace& GetWorkspace(size_t vertex_count);
+    };
+
+    template <typename Weight>
+    void ParetoRouter<Weight>::Workspace::Prepare(size_t vertex_count) {
+        if (best_counts.size() < vertex_count) {
+            best_counts.resize(vertex_count, NO_COUNT);
+        }
+    }
+
+    template <typename Weight>
+    void ParetoRouter<Weight>::Workspace::Reset() {
+        for (const uint32_t vertex : touched) {
+            best_counts[vertex] = NO_COUNT;
+        }
+        touched.clear();
+        arena.clear();
+        heap.clear();
+    }
+
+    template <typename Weight>
+    void ParetoRouter<Weight>::Workspace::Push(const Label& label) {
+        arena.push_back(label);
+        heap.emplace_back(label.weight, label.counted_edges, static_cast<uint32_t>(arena.size() - 1));
+        std::push_heap(heap.begin(), heap.end(), std::greater<HeapItem>{});
+    }
+
+    template <typename Weight>
+    template <typename IsCounted>
+    ParetoRouter<Weight>::ParetoRouter(const Graph& graph, IsCounted is_counted)
+        : graph_(graph)
+    {
+        if (!graph_.IsFrozen()) {
+            throw std::logic_error("Graph must be frozen before routing");
+        }
+        counted_.resize(graph_.GetEdgeCount());
+        for (EdgeId edge_id = 0; edge_id < graph_.GetEdgeCount(); ++edge_id) {
+            counted_[edge_id] = is_counted(edge_id) ? 1 : 0;
+        }
+    }
+
+    template <typename Weight>
+    typename ParetoRouter<Weight>::Workspace& ParetoRouter<Weight>::GetWorkspace(size_t vertex_count) {
+        thread_local Workspace workspace;
+        workspace.Prepare(vertex_count);
+        return workspace;
+    }
+
+    template <typename Weight>
+    std::vector<typename ParetoRouter<Weight>::RouteInfo> ParetoRouter<Weight>::BuildRoutes(VertexId from, VertexId to,
+        Weight max_extra_weight) const {
+        const size_t vertex_count = graph_.GetVertexCount();
+        if (from >= vertex_count || to >= vertex_count) {
+            throw std::out_of_range("Vertex is out of graph");
+        }
+
+        Workspace& workspace = GetWorkspace(vertex_count);
+        std::vector<uint32_t> target_labels;
+        // Предел веса путей: известен после того, как найден самый лёгкий путь
+        Weight max_weight = INFINITE_WEIGHT;
+
+        workspace.Push({ ZERO_WEIGHT, 0, static_cast<uint32_t>(from), NO_LABEL, NO_LABEL });
+        while (!workspace.heap.empty()) {
+            std::pop_heap(workspace.heap.begin(), workspace.heap.end(), std::greater<typename Workspace::HeapItem>{});
+            const auto [weight, counted_edges, label_index] = workspace.heap.back();
+            workspace.heap.pop_back();
+            if (max_weight < weight) {
+                break;
+            }
+
+            const uint32_t vertex = workspace.arena[label_index].vertex;
+            uint32_t& best_count = workspace.best_counts[vertex];
+            // Уже обработана метка не тяжелее и не больше учитываемых рёбер
+            if (best_count <= counted_edges) {
+                continue;
+            }
+            if (best_count == NO_COUNT) {
+                workspace.touched.push_back(vertex);
+            }
+            best_count = counted_edges;
+
+            if (vertex == to) {
+                if (target_labels.empty()) {
+                    max_weight = max_extra_weight < INFINITE_WEIGHT - weight ? weight + max_extra_weight : INFINITE_WEIGHT;
+                }
+                target_labels.push_back(label_index);
+                // Путь без учитываемых рёбер не улучшить
+                if (counted_edges == 0) {
+                    break;
+                }
+                continue;
+            }
+
+            const uint32_t target_best_count = workspace.best_counts[to];
+            const IncidentArcs<Weight> arcs = graph_.GetIncidentArcs(vertex);
+            for (size_t index = 0; index < arcs.count; ++index) {
+                const uint32_t next_count = counted_edges + counted_[arcs.edge_ids[index]];
+                // Метку отсекают уже обработанные метки следующей вершины и найденные пути до to:
+                // они не тяжелее, поэтому новая метка полезна, только если у неё меньше учитываемых рёбер
+                if (next_count >= workspace.best_counts[arcs.targets[index]] || next_count >= target_best_count) {
+                    continue;
+                }
+                workspace.Push({ weight + arcs.weights[index], next_count, arcs.targets[index], label_index, arcs.edge_ids[index] });
+            }
+        }
+
+        std::vector<RouteInfo> result;
+        result.reserve(target_labels.size());
+        for (const uint32_t target_label : target_labels) {
+            RouteInfo& route = result.emplace_back();
+            route.weight = workspace.arena[target_label].weight;
+            route.counted_edges = workspace.arena[target_label].counted_edges;
+            for (uint32_t label = target_label; workspace.arena[label].parent != NO_LABEL; label = workspace.arena[label].parent) {
+                route.edges.push_back(workspace.arena[label].edge_id);
+            }
+            std::reverse(route.edges.begin(), route.edges.end());
+        }
+
+        workspace.Reset();
+        return result;
+    }
+
+}  // namespace graph
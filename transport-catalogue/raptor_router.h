@@ -0,0 +1,309 @@
+#pragma once
+
+#include "transport_catalogue.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+#include <vector>
+
+namespace router {
+
+	// Поиск маршрута по раундам (RAPTOR) прямо по последовательностям остановок маршрутов, без графа.
+	// Раунд k находит лучшее время до остановок с k посадками: каждый рейс, на остановках которого
+	// время улучшилось в предыдущем раунде, просматривается один раз по порядку остановок.
+	// Рейс - последовательность остановок, которую автобус проезжает без пересадки: для кольцевого
+	// маршрута Stop1->...->StopN->Stop1, для некольцевого два рейса Stop1->...->StopN и StopN->...->Stop1,
+	// как и в транспортном графе. Все данные поиска - плоские массивы по номерам остановок и рейсов
+	template <typename Weight>
+	class RaptorRouter {
+	public:
+		static constexpr Weight INFINITE_WEIGHT = std::numeric_limits<Weight>::max();
+
+		// Поездка на одном автобусе: посадка на остановке board_stop и проезд span_count перегонов
+		struct Leg {
+			uint32_t bus_id;
+			const domain::Stop* board_stop;
+			uint32_t span_count;
+			Weight ride_weight;
+		};
+
+		struct RouteInfo {
+			Weight weight;
+			std::vector<Leg> legs;
+		};
+
+		// wait_weight - вес ожидания автобуса, ride_weight(distance) - вес проезда distance метров
+		template <typename RideWeight>
+		RaptorRouter(const Catalogue::TransportCatalogue& catalogue, Weight wait_weight, RideWeight ride_weight);
+
+		// Маршрут между остановками с номерами domain::Stop::id_, nullopt - пути нет
+		std::optional<RouteInfo> BuildRoute(size_t from_stop_id, size_t to_stop_id) const;
+		// Вес кратчайшего пути от остановки from до каждой остановки по её номеру, INFINITE_WEIGHT - пути нет
+		std::vector<Weight> ComputeWeights(size_t from_stop_id) const;
+
+		size_t GetTripCount() const;
+		size_t GetMemoryUsage() const;
+
+	private:
+		static constexpr uint32_t NO_POSITION = std::numeric_limits<uint32_t>::max();
+		static constexpr size_t NO_ROUND = std::numeric_limits<size_t>::max();
+
+		// Лучшее время до остановки в раунде и рейс, которым до неё доехали
+		struct Label {
+			Weight arrival;
+			uint32_t trip;
+			uint32_t board_position;
+			uint32_t alight_position;
+		};
+
+		// Буферы поиска. Заводятся по одному на поток, поэтому запросы из разных потоков не мешают друг другу
+		struct Workspace {
+			// Метки всех раундов подряд: метки раунда k - элементы с k * stop_count по (k + 1) * stop_count - 1
+			std::vector<Label> labels;
+			// Лучшее время до остановки по всем раундам
+			std::vector<Weight> best;
+			std::vector<uint8_t> marked;
+			std::vector<uint32_t> marked_stops;
+			// Первая позиция рейса, с которой его нужно просмотреть в текущем раунде
+			std::vector<uint32_t> trip_first_positions;
+			std::vector<uint32_t> queued_trips;
+		};
+
+		size_t stop_count_;
+		const Catalogue::TransportCatalogue& catalogue_;
+		Weight wait_weight_;
+
+		// Остановки рейса t - элементы с trip_offsets_[t] по trip_offsets_[t + 1] - 1 массива trip_stops_,
+		// segment_weights_[i] - вес проезда от остановки trip_stops_[i] до следующей остановки рейса
+		std::vector<uint32_t> trip_offsets_;
+		std::vector<uint32_t> trip_stops_;
+		std::vector<Weight> segment_weights_;
+		std::vector<uint32_t> trip_bus_ids_;
+
+		// Рейсы, проходящие через остановку s, и позиции остановки в них - элементы
+		// с stop_trip_offsets_[s] по stop_trip_offsets_[s + 1] - 1 массивов stop_trips_ и stop_positions_
+		std::vector<uint32_t> stop_trip_offsets_;
+		std::vector<uint32_t> stop_trips_;
+		std::vector<uint32_t> stop_positions_;
+
+		void AddTrip(uint32_t bus_id, const std::vector<const domain::Stop*>& stops);
+		template <typename RideWeight>
+		void AddSegmentWeights(const std::vector<const domain::Stop*>& stops, RideWeight& ride_weight);
+		void IndexStopTrips();
+
+		// Выполняет раунды поиска от остановки from. Если задана остановка to, метки, не лучшие времени до неё,
+		// отбрасываются. Возвращает раунд, в котором найдено лучшее время до to, либо NO_ROUND
+		size_t RunRounds(Workspace& workspace, uint32_t from, std::optional<uint32_t> to) const;
+		static Workspace& GetWorkspace();
+	};
+
+	template <typename Weight>
+	template <typename RideWeight>
+	RaptorRouter<Weight>::RaptorRouter(const Catalogue::TransportCatalogue& catalogue, Weight wait_weight,
+		RideWeight ride_weight)
+		: stop_count_(catalogue.GetStopCount()), catalogue_(catalogue), wait_weight_(wait_weight) {
+		trip_offsets_.push_back(0);
+		for (uint32_t bus_id = 0; bus_id < catalogue_.GetBusCount(); ++bus_id) {
+			const domain::Bus& bus = catalogue_.GetBus(bus_id);
+			if (bus.stops_.size() < 2) {
+				continue;
+			}
+			if (bus.is_circular_) {
+				std::vector<const domain::Stop*> trip(bus.stops_.begin(), bus.stops_.end());
+				trip.push_back(bus.stops_.front());
+				AddTrip(bus_id, trip);
+				AddSegmentWeights(trip, ride_weight);
+			}
+			else {
+				const std::vector<const domain::Stop*> reversed(bus.stops_.rbegin(), bus.stops_.rend());
+				AddTrip(bus_id, bus.stops_);
+				AddSegmentWeights(bus.stops_, ride_weight);
+				AddTrip(bus_id, reversed);
+				AddSegmentWeights(reversed, ride_weight);
+			}
+		}
+		IndexStopTrips();
+	}
+
+	template <typename Weight>
+	void RaptorRouter<Weight>::AddTrip(uint32_t bus_id, const std::vector<const domain::Stop*>& stops) {
+		for (const domain::Stop* stop : stops) {
+			trip_stops_.push_back(static_cast<uint32_t>(stop->id_));
+		}
+		trip_offsets_.push_back(static_cast<uint32_t>(trip_stops_.size()));
+		trip_bus_ids_.push_back(bus_id);
+	}
+
+	template <typename Weight>
+	template <typename RideWeight>
+	void RaptorRouter<Weight>::AddSegmentWeights(const std::vector<const domain::Stop*>& stops, RideWeight& ride_weight) {
+		for (size_t position = 0; position + 1 < stops.size(); ++position) {
+			segment_weights_.push_back(ride_weight(catalogue_.GetStopToStopDistance(stops[position], stops[position + 1])));
+		}
+		// С конечной рейса дальше не едут
+		segment_weights_.push_back(Weight{});
+	}
+
+	template <typename Weight>
+	void RaptorRouter<Weight>::IndexStopTrips() {
+		// Подсчёт вхождений каждой остановки, затем раскладка по сдвигам
+		stop_trip_offsets_.assign(stop_count_ + 1, 0);
+		for (const uint32_t stop : trip_stops_) {
+			++stop_trip_offsets_[stop + 1];
+		}
+		for (size_t stop = 0; stop < stop_count_; ++stop) {
+			stop_trip_offsets_[stop + 1] += stop_trip_offsets_[stop];
+		}
+
+		std::vector<uint32_t> next_positions(stop_trip_offsets_.begin(), stop_trip_offsets_.end() - 1);
+		stop_trips_.resize(trip_stops_.size());
+		stop_positions_.resize(trip_stops_.size());
+		for (uint32_t trip = 0; trip + 1 < trip_offsets_.size(); ++trip) {
+			for (uint32_t index = trip_offsets_[trip]; index < trip_offsets_[trip + 1]; ++index) {
+				const uint32_t slot = next_positions[trip_stops_[index]]++;
+				stop_trips_[slot] = trip;
+				stop_positions_[slot] = index - trip_offsets_[trip];
+			}
+		}
+	}
+
+	template <typename Weight>
+	typename RaptorRouter<Weight>::Workspace& RaptorRouter<Weight>::GetWorkspace() {
+		thread_local Workspace workspace;
+		return workspace;
+	}
+
+	template <typename Weight>
+	size_t RaptorRouter<Weight>::RunRounds(Workspace& workspace, uint32_t from, std::optional<uint32_t> to) const {
+		const Label empty_label{ INFINITE_WEIGHT, NO_POSITION, NO_POSITION, NO_POSITION };
+		workspace.labels.assign(stop_count_, empty_label);
+		workspace.best.assign(stop_count_, INFINITE_WEIGHT);
+		workspace.marked.assign(stop_count_, 0);
+		workspace.trip_first_positions.assign(trip_bus_ids_.size(), NO_POSITION);
+		workspace.marked_stops.clear();
+		workspace.queued_trips.clear();
+
+		workspace.labels[from].arrival = workspace.best[from] = Weight{};
+		workspace.marked_stops.push_back(from);
+		size_t target_round = to && *to == from ? 0 : NO_ROUND;
+
+		for (size_t round = 1; !workspace.marked_stops.empty(); ++round) {
+			// Рейсы через отмеченные остановки, каждый с самой ранней отмеченной позиции
+			for (const uint32_t stop : workspace.marked_stops) {
+				workspace.marked[stop] = 0;
+				for (uint32_t index = stop_trip_offsets_[stop]; index < stop_trip_offsets_[stop + 1]; ++index) {
+					uint32_t& first_position = workspace.trip_first_positions[stop_trips_[index]];
+					if (first_position == NO_POSITION) {
+						workspace.queued_trips.push_back(stop_trips_[index]);
+					}
+					first_position = std::min(first_position, stop_positions_[index]);
+				}
+			}
+			workspace.marked_stops.clear();
+
+			const size_t previous_base = (round - 1) * stop_count_;
+			const size_t current_base = round * stop_count_;
+			workspace.labels.resize(current_base + stop_count_, empty_label);
+
+			for (const uint32_t trip : workspace.queued_trips) {
+				const uint32_t trip_begin = trip_offsets_[trip];
+				const uint32_t trip_size = trip_offsets_[trip + 1] - trip_begin;
+				uint32_t board_position = NO_POSITION;
+				Weight arrival = INFINITE_WEIGHT;
+
+				for (uint32_t position = workspace.trip_first_positions[trip]; position < trip_size; ++position) {
+					const uint32_t stop = trip_stops_[trip_begin + position];
+					// Высадка, если так быстрее, чем по всем найденным ранее путям до остановки и до цели
+					if (board_position != NO_POSITION) {
+						const Weight bound = to ? std::min(workspace.best[stop], workspace.best[*to]) : workspace.best[stop];
+						if (arrival < bound) {
+							workspace.best[stop] = arrival;
+							workspace.labels[current_base + stop] = { arrival, trip, board_position, position };
+							if (!workspace.marked[stop]) {
+								workspace.marked[stop] = 1;
+								workspace.marked_stops.push_back(stop);
+							}
+							if (to && stop == *to) {
+								target_round = round;
+							}
+						}
+					}
+					// Посадка заново, если до остановки добрались в предыдущем раунде быстрее, чем едет автобус
+					const Weight previous_arrival = workspace.labels[previous_base + stop].arrival;
+					if (previous_arrival != INFINITE_WEIGHT && previous_arrival + wait_weight_ < arrival) {
+						arrival = previous_arrival + wait_weight_;
+						board_position = position;
+					}
+					if (board_position != NO_POSITION) {
+						arrival += segment_weights_[trip_begin + position];
+					}
+				}
+				workspace.trip_first_positions[trip] = NO_POSITION;
+			}
+			workspace.queued_trips.clear();
+		}
+
+		return target_round;
+	}
+
+	template <typename Weight>
+	std::optional<typename RaptorRouter<Weight>::RouteInfo> RaptorRouter<Weight>::BuildRoute(size_t from_stop_id,
+		size_t to_stop_id) const {
+		if (from_stop_id >= stop_count_ || to_stop_id >= stop_count_) {
+			throw std::out_of_range("Stop is out of catalogue");
+		}
+
+		Workspace& workspace = GetWorkspace();
+		const uint32_t to = static_cast<uint32_t>(to_stop_id);
+		size_t round = RunRounds(workspace, static_cast<uint32_t>(from_stop_id), to);
+		if (round == NO_ROUND) {
+			return std::nullopt;
+		}
+
+		// Восстанавливаем поездки с последней: посадка каждой - на остановке, до которой доехали раундом раньше
+		RouteInfo route{ workspace.best[to], {} };
+		for (uint32_t stop = to; round > 0; --round) {
+			const Label& label = workspace.labels[round * stop_count_ + stop];
+			const uint32_t trip_begin = trip_offsets_[label.trip];
+			Weight ride_weight{};
+			for (uint32_t position = label.board_position; position < label.alight_position; ++position) {
+				ride_weight += segment_weights_[trip_begin + position];
+			}
+			stop = trip_stops_[trip_begin + label.board_position];
+			route.legs.push_back({
+				trip_bus_ids_[label.trip],
+				&catalogue_.GetStop(stop),
+				label.alight_position - label.board_position,
+				ride_weight
+			});
+		}
+		std::reverse(route.legs.begin(), route.legs.end());
+		return route;
+	}
+
+	template <typename Weight>
+	std::vector<Weight> RaptorRouter<Weight>::ComputeWeights(size_t from_stop_id) const {
+		if (from_stop_id >= stop_count_) {
+			throw std::out_of_range("Stop is out of catalogue");
+		}
+		Workspace& workspace = GetWorkspace();
+		RunRounds(workspace, static_cast<uint32_t>(from_stop_id), std::nullopt);
+		return workspace.best;
+	}
+
+	template <typename Weight>
+	size_t RaptorRouter<Weight>::GetTripCount() const {
+		return trip_bus_ids_.size();
+	}
+
+	template <typename Weight>
+	size_t RaptorRouter<Weight>::GetMemoryUsage() const {
+		return (trip_offsets_.capacity() + trip_stops_.capacity() + trip_bus_ids_.capacity()
+			+ stop_trip_offsets_.capacity() + stop_trips_.capacity() + stop_positions_.capacity()) * sizeof(uint32_t)
+			+ segment_weights_.capacity() * sizeof(Weight);
+	}
+
+}
@@ -29,6 +29,15 @@ namespace RqstHandler {
 		ExecuteOutputRequests(loader.ParseOutputRequests());		
 	}
 
+	router::TransportRouter& RequestHandler::GetRouter() {
+		if (!router_) {
+			router_ = make_router_();
+			// ,  make_router_,   
+			make_router_ = nullptr;
+		}
+		return *router_;
+	}
+
 	void RequestHandler::PrintToJSON(std::ostream& output) {		
 		json::Print(json::Document( json_result_.Build()), output);
 	}
@@ -82,6 +91,12 @@ namespace RqstHandler {
 		//    ["request_id"] = id 
 		//    ["map"] =     
 		// 4.  -    
+		// 5.  -      , :
+		//    ["request_id"] = id 
+		//    ["times"] =     ,        null
+		// 6.  -   ,    , :
+		//    ["request_id"] = id 
+		//    ["stops"] =   {"stop_name", "time"}    
 		json_result_.StartArray();
 
 		for (const auto& req : requests) {
@@ -137,9 +152,67 @@ namespace RqstHandler {
 				json_result_.EndDict();
 			}
 			//    
+			else if (std::holds_alternative<JSONReader::RouteOutputRequest>(req)
+				&& std::get<JSONReader::RouteOutputRequest>(req).time_only_) {
+				const auto& route_req = std::get<JSONReader::RouteOutputRequest>(req);
+				const auto total_time = GetRouter().ComputeTravelTime(route_req.from_, route_req.to_);
+
+				json_result_.StartDict();
+				json_result_.Key("request_id").Value(route_req.request_id_);
+				if (total_time) {
+					json_result_.Key("total_time").Value(*total_time);
+				}
+				else {
+					json_result_.Key("error_message").Value("not found");
+				}
+				json_result_.EndDict();
+			}
+			else if (std::holds_alternative<JSONReader::RouteOutputRequest>(req)
+				&& std::get<JSONReader::RouteOutputRequest>(req).pareto_) {
+				const auto& route_req = std::get<JSONReader::RouteOutputRequest>(req);
+				const auto routes = GetRouter().BuildParetoRoutes(route_req.from_, route_req.to_, route_req.max_extra_time_);
+
+				json_result_.StartDict();
+				json_result_.Key("request_id").Value(route_req.request_id_);
+				if (!routes.empty()) {
+					json_result_.Key("routes").StartArray();
+					for (const auto& route : routes) {
+						json_result_.StartDict();
+						json_result_.Key("transfer_count").Value(route.transfer_count);
+						PrintRoute(route.route_data);
+						json_result_.EndDict();
+					}
+					json_result_.EndArray();
+				}
+				else {
+					json_result_.Key("error_message").Value("not found");
+				}
+				json_result_.EndDict();
+			}
+			else if (std::holds_alternative<JSONReader::RouteOutputRequest>(req)
+				&& std::get<JSONReader::RouteOutputRequest>(req).alternatives_ > 0) {
+				const auto& route_req = std::get<JSONReader::RouteOutputRequest>(req);
+				const auto routes = GetRouter().BuildAlternativeRoutes(route_req.from_, route_req.to_, route_req.alternatives_);
+
+				json_result_.StartDict();
+				json_result_.Key("request_id").Value(route_req.request_id_);
+				if (!routes.empty()) {
+					json_result_.Key("routes").StartArray();
+					for (const auto& route : routes) {
+						json_result_.StartDict();
+						PrintRoute(route);
+						json_result_.EndDict();
+					}
+					json_result_.EndArray();
+				}
+				else {
+					json_result_.Key("error_message").Value("not found");
+				}
+				json_result_.EndDict();
+			}
 			else if (std::holds_alternative<JSONReader::RouteOutputRequest>(req)) {
 				//  
-				const auto result = router_->BuildTransportRoute(
+				const auto result = GetRouter().BuildTransportRoute(
 					std::get<JSONReader::RouteOutputRequest>(req).from_,
 					std::get<JSONReader::RouteOutputRequest>(req).to_);
 
@@ -147,23 +220,50 @@ namespace RqstHandler {
 				json_result_.Key("request_id").Value(std::get<JSONReader::RouteOutputRequest>(req).request_id_);
 
 				if (result.has_value()) {
-					json_result_.Key("total_time").Value(result.value().total_time_);
-					json_result_.Key("items").StartArray();
+					PrintRoute(result.value());
+				}
+				else {
+					json_result_.Key("error_message").Value("not found");
+				}
 
-					for (const auto& point : result.value().route_points) {
-						json_result_.StartDict();
+				json_result_.EndDict();
+			}
+			//      
+			else if (std::holds_alternative<JSONReader::MatrixOutputRequest>(req)) {
+				const auto& matrix_req = std::get<JSONReader::MatrixOutputRequest>(req);
+				const router::TravelTimeMatrix times = GetRouter().ComputeTravelTimeMatrix(matrix_req.from_, matrix_req.to_);
 
-						if (std::holds_alternative<router::RouteWaitInfo>(point)) {
-							json_result_.Key("type").Value("Wait");
-							json_result_.Key("stop_name").Value(std::string(std::get<router::RouteWaitInfo>(point).stop_name));
-							json_result_.Key("time").Value(std::get<router::RouteWaitInfo>(point).time);							
+				json_result_.StartDict();
+				json_result_.Key("request_id").Value(matrix_req.request_id_);
+				json_result_.Key("times").StartArray();
+				for (const auto& row : times) {
+					json_result_.StartArray();
+					for (const auto& time : row) {
+						if (time) {
+							json_result_.Value(*time);
 						}
-						else if (std::holds_alternative<router::RouteBusInfo>(point)) {
-							json_result_.Key("type").Value("Bus");
-							json_result_.Key("bus").Value(std::string(std::get<router::RouteBusInfo>(point).bus_name));
-							json_result_.Key("span_count").Value(std::get<router::RouteBusInfo>(point).span_count);
-							json_result_.Key("time").Value(std::get<router::RouteBusInfo>(point).time);
+						else {
+							json_result_.Value(nullptr);
 						}
+					}
+					json_result_.EndArray();
+				}
+				json_result_.EndArray();
+				json_result_.EndDict();
+			}
+			//   ,    
+			else if (std::holds_alternative<JSONReader::ReachableOutputRequest>(req)) {
+				const auto& reachable_req = std::get<JSONReader::ReachableOutputRequest>(req);
+				const auto stops = GetRouter().ComputeReachableStops(reachable_req.from_, reachable_req.max_time_);
+
+				json_result_.StartDict();
+				json_result_.Key("request_id").Value(reachable_req.request_id_);
+				if (stops.has_value()) {
+					json_result_.Key("stops").StartArray();
+					for (const auto& stop : *stops) {
+						json_result_.StartDict();
+						json_result_.Key("stop_name").Value(std::string(stop.stop_name));
+						json_result_.Key("time").Value(stop.time);
 						json_result_.EndDict();
 					}
 					json_result_.EndArray();
@@ -171,7 +271,6 @@ namespace RqstHandler {
 				else {
 					json_result_.Key("error_message").Value("not found");
 				}
-
 				json_result_.EndDict();
 			}
 		}
@@ -179,6 +278,29 @@ namespace RqstHandler {
 		json_result_.EndArray();
 	}	
 
+	void RequestHandler::PrintRoute(const router::RouteData& route) {
+		json_result_.Key("total_time").Value(route.total_time_);
+		json_result_.Key("items").StartArray();
+
+		for (const auto& point : route.route_points) {
+			json_result_.StartDict();
+
+			if (std::holds_alternative<router::RouteWaitInfo>(point)) {
+				json_result_.Key("type").Value("Wait");
+				json_result_.Key("stop_name").Value(std::string(std::get<router::RouteWaitInfo>(point).stop_name));
+				json_result_.Key("time").Value(std::get<router::RouteWaitInfo>(point).time);							
+			}
+			else if (std::holds_alternative<router::RouteBusInfo>(point)) {
+				json_result_.Key("type").Value("Bus");
+				json_result_.Key("bus").Value(std::string(std::get<router::RouteBusInfo>(point).bus_name));
+				json_result_.Key("span_count").Value(std::get<router::RouteBusInfo>(point).span_count);
+				json_result_.Key("time").Value(std::get<router::RouteBusInfo>(point).time);
+			}
+			json_result_.EndDict();
+		}
+		json_result_.EndArray();
+	}
+
 	svg::Document RequestHandler::RenderMap() {				
 		//       
 		const std::set<std::string_view>& buses = db_.GetBuses();
@@ -292,33 +414,61 @@ namespace RqstHandler {
 		router::TransportRouterSettings router_settings = loader.ParseRouterSettings();
 		//    ,      
 		ExecuteInputRequests(input_requests);
-		//  ,    
+		//  ,    . RAPTOR   ,    
 		router_ = std::make_unique<router::TransportRouter>(db_, router_settings);	
+		if (router_settings.memory_report_) {
+			std::cerr << "Catalogue names: " << db_.GetNameMemoryUsage() << " bytes\n";
+			router_->PrintMemoryReport(std::cerr);
+		}
 
 		serializer.SerializeTransportCatalogue(
 			std::move(input_requests),
 			std::move(loader.ParseRenderSettings()),
 			std::move(loader.ParseRouterSettings()),
-			router_->GetGraph()
+			router_->GetGraph(),
+			router_->GetStopVertexes(),
+			router_->GetConnectivity(),
+			router_->GetAllPairsRouter(),
+			router_->GetContractionHierarchy(),
+			router_->GetHubLabels()
 		);
 	}
 
 	void RequestHandler::Deserialize(Path file) {
-		serialization::TransportCatalogueSerializer deserializer(file);
+		//       :        
+		auto deserializer = std::make_shared<serialization::TransportCatalogueSerializer>(file);
 
 		JSONReader::InputRequestPool input_requests;
 		router::TransportRouterSettings router_settings;
-		graph::DirectedWeightedGraph<double> graph;
 
-		std::tie( input_requests , render_settings_, router_settings, graph) = std::move(deserializer.DeserializeTransportCatalogue());
+		std::tie( input_requests , render_settings_, router_settings) = std::move(deserializer->DeserializeTransportCatalogue());
+		//        make_base:      
+		loader.ParseRoutingMetric(router_settings);
 
 		//     
 		ExecuteInputRequests(std::move(input_requests));
-		//     
-		router_ = std::make_unique<router::TransportRouter>(db_, router_settings, std::move(graph));
+		if (router_settings.memory_report_) {
+			std::cerr << "Catalogue names: " << db_.GetNameMemoryUsage() << " bytes\n";
+		}
+		//       ,        
+		//      ,  make_router_     
+		make_router_ = [this, deserializer, router_settings]() {
+			auto [graph, precomputed] = deserializer->DeserializeRouterData();
+			auto router = std::make_unique<router::TransportRouter>(db_, router_settings, std::move(graph), std::move(precomputed));
+			if (router_settings.memory_report_) {
+				router->PrintMemoryReport(std::cerr);
+			}
+			return router;
+		};
 		
 		//        
 		ExecuteOutputRequests(std::move(loader.ParseOutputRequests()));
+
+		if (router_ && router_settings.memory_report_ && router_settings.route_cache_capacity_ > 0) {
+			const cache::CacheStats stats = router_->GetRouteCacheStats();
+			std::cerr << "Route cache: " << stats.hits << " hits, " << stats.misses << " misses, "
+				<< stats.size << "/" << stats.capacity << " entries\n";
+		}
 	}
 
 } // namespace RqstHandler
\ No newline at end of file
@@ -6,6 +6,7 @@
 #include "json_builder.h"
 #include "serialization.h"
 
+#include <functional>
 #include <iostream>
 #include <sstream>
 #include <memory>
@@ -50,14 +51,22 @@ namespace RqstHandler {
 		// json::Array requests_result_;
 		json::Builder json_result_;
 		std::unique_ptr<router::TransportRouter> router_ = nullptr;
+		//  ,         
+		std::function<std::unique_ptr<router::TransportRouter>()> make_router_;
 		renderer::RenderSettings render_settings_;
 
+		//  ,       make_router_
+		router::TransportRouter& GetRouter();
+
 		//   
 		void ExecuteOutputRequests(const JSONReader::OutputRequestPool& requests);		
 
 		//       
 		void ExecuteInputRequests(const JSONReader::InputRequestPool& requests);
 
+		//         
+		void PrintRoute(const router::RouteData& route);
+
 		//       
 		//   -   
 	};
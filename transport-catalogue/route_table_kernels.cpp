@@ -0,0 +1,131 @@
+#include "route_table_kernels.h"
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define ROUTE_TABLE_KERNELS_X86
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+#endif
+
+// Для GCC и Clang функции с AVX2 собираются с атрибутом target, без глобального флага -mavx2
+#if defined(ROUTE_TABLE_KERNELS_X86) && (defined(__GNUC__) || defined(__clang__))
+#define ROUTE_TABLE_KERNELS_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define ROUTE_TABLE_KERNELS_TARGET_AVX2
+#endif
+
+namespace graph {
+
+	namespace {
+
+		void RelaxRowScalar(float weight_through, const float* through_weights, const uint32_t* through_prev_edges,
+			float* weights, uint32_t* prev_edges, size_t count) {
+			for (size_t j = 0; j < count; ++j) {
+				const float candidate = weight_through + through_weights[j];
+				if (candidate < weights[j]) {
+					weights[j] = candidate;
+					prev_edges[j] = through_prev_edges[j];
+				}
+			}
+		}
+
+#ifdef ROUTE_TABLE_KERNELS_X86
+		void RelaxRowSse2(float weight_through, const float* through_weights, const uint32_t* through_prev_edges,
+			float* weights, uint32_t* prev_edges, size_t count) {
+			const __m128 through = _mm_set1_ps(weight_through);
+			size_t j = 0;
+			for (; j + 4 <= count; j += 4) {
+				const __m128 candidate = _mm_add_ps(through, _mm_loadu_ps(through_weights + j));
+				const __m128 current = _mm_loadu_ps(weights + j);
+				const __m128 mask = _mm_cmplt_ps(candidate, current);
+				// Ни одна ячейка не улучшилась - ничего не пишем
+				if (_mm_movemask_ps(mask) == 0) {
+					continue;
+				}
+				_mm_storeu_ps(weights + j, _mm_or_ps(_mm_and_ps(mask, candidate), _mm_andnot_ps(mask, current)));
+
+				const __m128i mask_int = _mm_castps_si128(mask);
+				const __m128i current_edges = _mm_loadu_si128(reinterpret_cast<const __m128i*>(prev_edges + j));
+				const __m128i through_edges = _mm_loadu_si128(reinterpret_cast<const __m128i*>(through_prev_edges + j));
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(prev_edges + j),
+					_mm_or_si128(_mm_and_si128(mask_int, through_edges), _mm_andnot_si128(mask_int, current_edges)));
+			}
+			RelaxRowScalar(weight_through, through_weights + j, through_prev_edges + j, weights + j, prev_edges + j, count - j);
+		}
+
+		ROUTE_TABLE_KERNELS_TARGET_AVX2
+		void RelaxRowAvx2(float weight_through, const float* through_weights, const uint32_t* through_prev_edges,
+			float* weights, uint32_t* prev_edges, size_t count) {
+			const __m256 through = _mm256_set1_ps(weight_through);
+			size_t j = 0;
+			for (; j + 8 <= count; j += 8) {
+				const __m256 candidate = _mm256_add_ps(through, _mm256_loadu_ps(through_weights + j));
+				const __m256 current = _mm256_loadu_ps(weights + j);
+				const __m256 mask = _mm256_cmp_ps(candidate, current, _CMP_LT_OQ);
+				// Ни одна ячейка не улучшилась - ничего не пишем
+				if (_mm256_movemask_ps(mask) == 0) {
+					continue;
+				}
+				_mm256_storeu_ps(weights + j, _mm256_blendv_ps(current, candidate, mask));
+
+				const __m256i current_edges = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(prev_edges + j));
+				const __m256i through_edges = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(through_prev_edges + j));
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(prev_edges + j),
+					_mm256_blendv_epi8(current_edges, through_edges, _mm256_castps_si256(mask)));
+			}
+			RelaxRowScalar(weight_through, through_weights + j, through_prev_edges + j, weights + j, prev_edges + j, count - j);
+		}
+
+		bool CpuSupportsAvx2() {
+#if defined(__GNUC__) || defined(__clang__)
+			return __builtin_cpu_supports("avx2");
+#elif defined(_MSC_VER)
+			int info[4];
+			__cpuid(info, 0);
+			if (info[0] < 7) {
+				return false;
+			}
+			__cpuid(info, 1);
+			// Процессор и ОС должны поддерживать сохранение регистров AVX (OSXSAVE + XCR0)
+			const bool os_saves_avx = (info[2] & (1 << 27)) && ((_xgetbv(0) & 0x6) == 0x6);
+			__cpuidex(info, 7, 0);
+			return os_saves_avx && (info[1] & (1 << 5));
+#else
+			return false;
+#endif
+		}
+#endif
+
+		struct SelectedKernel {
+			RelaxRowKernel kernel;
+			const char* name;
+		};
+
+		SelectedKernel SelectRelaxRowKernel() {
+#ifdef ROUTE_TABLE_KERNELS_X86
+			if (CpuSupportsAvx2()) {
+				return { RelaxRowAvx2, "AVX2" };
+			}
+			return { RelaxRowSse2, "SSE2" };
+#else
+			return { RelaxRowScalar, "scalar" };
+#endif
+		}
+
+		const SelectedKernel& GetSelectedKernel() {
+			static const SelectedKernel selected = SelectRelaxRowKernel();
+			return selected;
+		}
+
+	} // namespace
+
+	RelaxRowKernel GetRelaxRowKernel() {
+		return GetSelectedKernel().kernel;
+	}
+
+	const char* GetRelaxRowKernelName() {
+		return GetSelectedKernel().name;
+	}
+
+} // namespace graph
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace graph {
+
+	// Релаксация части строки таблицы маршрутов через промежуточную вершину (операция min-plus):
+	// для всех j из [0, count), если weight_through + through_weights[j] < weights[j], то
+	// weights[j] = weight_through + through_weights[j] и prev_edges[j] = through_prev_edges[j].
+	// Недостижимые ячейки хранят +inf, поэтому не требуют отдельной проверки
+	using RelaxRowKernel = void (*)(
+		float weight_through,
+		const float* through_weights,
+		const uint32_t* through_prev_edges,
+		float* weights,
+		uint32_t* prev_edges,
+		size_t count);
+
+	// Возвращает реализацию, лучшую для текущего процессора: AVX2, SSE2 или скалярную.
+	// Выбор делается один раз, при первом вызове
+	RelaxRowKernel GetRelaxRowKernel();
+
+	// Название выбранной реализации, для отчётов
+	const char* GetRelaxRowKernelName();
+
+} // namespace graph
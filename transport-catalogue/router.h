@@ -1,19 +1,35 @@
 #pragma once
 
 #include "graph.h"
+#include "route_table_kernels.h"
+#include "thread_pool.h"
 
 #include <algorithm>
 #include <cassert>
 #include <cstdint>
 #include <iterator>
+#include <limits>
 #include <optional>
 #include <stdexcept>
+#include <type_traits>
 #include <unordered_map>
 #include <utility>
 #include <vector>
 
 namespace graph {
 
+    //  ,    .     float:
+    //      ,       
+    template <typename Weight>
+    struct RouteTableWeight {
+        using Type = Weight;
+    };
+
+    template <>
+    struct RouteTableWeight<double> {
+        using Type = float;
+    };
+
     // ,        .
     template <typename Weight>
     class Router {
@@ -21,7 +37,25 @@ namespace graph {
         using Graph = DirectedWeightedGraph<Weight>;
 
     public:
+        using TableWeight = typename RouteTableWeight<Weight>::Type;
+
+        //  :     id      
+        //  ,  (from, to)   from * vertex_count + to
+        struct RoutesInternalData {
+            std::vector<TableWeight> weights;
+            std::vector<uint32_t> prev_edges;
+        };
+
+        //  ,  
+        static constexpr TableWeight UNREACHABLE_WEIGHT = std::numeric_limits<TableWeight>::has_infinity
+            ? std::numeric_limits<TableWeight>::infinity()
+            : std::numeric_limits<TableWeight>::max();
+        //        ( ,  )
+        static constexpr uint32_t NO_EDGE = std::numeric_limits<uint32_t>::max();
+
         explicit Router(const Graph& graph);
+        //       ,   
+        Router(const Graph& graph, RoutesInternalData&& routes_internal_data);
 
         struct RouteInfo {
             Weight weight;
@@ -29,90 +63,218 @@ namespace graph {
         };
 
         std::optional<RouteInfo> BuildRoute(VertexId from, VertexId to) const;
+        //        , nullopt -  
+        std::optional<Weight> GetWeight(VertexId from, VertexId to) const;
+
+        const RoutesInternalData& GetRoutesInternalData() const;
+
+        //  ,   ,  
+        size_t GetRoutesTableMemoryUsage() const;
 
     private:
-        struct RouteInternalData {
-            Weight weight;
-            std::optional<EdgeId> prev_edge;
-        };
-        using RoutesInternalData = std::vector<std::vector<std::optional<RouteInternalData>>>;
+        size_t GetCellIndex(VertexId from, VertexId to) const {
+            return from * vertex_count_ + to;
+        }
 
         void InitializeRoutesInternalData(const Graph& graph) {
-            const size_t vertex_count = graph.GetVertexCount();
-            for (VertexId vertex = 0; vertex < vertex_count; ++vertex) {
-                routes_internal_data_[vertex][vertex] = RouteInternalData{ ZERO_WEIGHT, std::nullopt };
-                for (const EdgeId edge_id : graph.GetIncidentEdges(vertex)) {
-                    const auto& edge = graph.GetEdge(edge_id);
-                    if (edge.weight < ZERO_WEIGHT) {
+            if (graph.GetEdgeCount() >= NO_EDGE) {
+                throw std::length_error("Too many edges for the routes table");
+            }
+            auto& weights = routes_internal_data_.weights;
+            auto& prev_edges = routes_internal_data_.prev_edges;
+            for (VertexId vertex = 0; vertex < vertex_count_; ++vertex) {
+                weights[GetCellIndex(vertex, vertex)] = ZERO_WEIGHT;
+                const IncidentArcs<Weight> arcs = graph.GetIncidentArcs(vertex);
+                for (size_t i = 0; i < arcs.count; ++i) {
+                    if (arcs.weights[i] < Weight{}) {
                         throw std::domain_error("Edges' weights should be non-negative");
                     }
-                    auto& route_internal_data = routes_internal_data_[vertex][edge.to];
-                    if (!route_internal_data || route_internal_data->weight > edge.weight) {
-                        route_internal_data = RouteInternalData{ edge.weight, edge_id };
+                    const size_t cell = GetCellIndex(vertex, arcs.targets[i]);
+                    const TableWeight edge_weight = static_cast<TableWeight>(arcs.weights[i]);
+                    if (weights[cell] > edge_weight) {
+                        weights[cell] = edge_weight;
+                        prev_edges[cell] = static_cast<uint32_t>(arcs.edge_ids[i]);
                     }
                 }
             }
         }
 
-        void RelaxRoute(VertexId vertex_from, VertexId vertex_to, const RouteInternalData& route_from,
-            const RouteInternalData& route_to) {
-            auto& route_relaxing = routes_internal_data_[vertex_from][vertex_to];
-            const Weight candidate_weight = route_from.weight + route_to.weight;
-            if (!route_relaxing || candidate_weight < route_relaxing->weight) {
-                route_relaxing = { candidate_weight,
-                                  route_to.prev_edge ? route_to.prev_edge : route_from.prev_edge };
+        //       .
+        //          :      
+        //        ,  NO_EDGE     
+        static void RelaxRow(TableWeight weight_through, const TableWeight* through_weights, const uint32_t* through_prev_edges,
+            TableWeight* weights, uint32_t* prev_edges, size_t count) {
+            if constexpr (std::is_same_v<TableWeight, float>) {
+                GetRelaxRowKernel()(weight_through, through_weights, through_prev_edges, weights, prev_edges, count);
+            }
+            else {
+                for (size_t j = 0; j < count; ++j) {
+                    if (through_weights[j] == UNREACHABLE_WEIGHT) {
+                        continue;
+                    }
+                    const TableWeight candidate_weight = weight_through + through_weights[j];
+                    if (candidate_weight < weights[j]) {
+                        weights[j] = candidate_weight;
+                        prev_edges[j] = through_prev_edges[j];
+                    }
+                }
             }
         }
 
-        void RelaxRoutesInternalDataThroughVertex(size_t vertex_count, VertexId vertex_through) {
-            for (VertexId vertex_from = 0; vertex_from < vertex_count; ++vertex_from) {
-                if (const auto& route_from = routes_internal_data_[vertex_from][vertex_through]) {
-                    for (VertexId vertex_to = 0; vertex_to < vertex_count; ++vertex_to) {
-                        if (const auto& route_to = routes_internal_data_[vertex_through][vertex_to]) {
-                            RelaxRoute(vertex_from, vertex_to, *route_from, *route_to);
-                        }
+        //     (block_from x block_to)    block_through
+        void RelaxBlock(size_t block_from, size_t block_to, size_t block_through) {
+            const VertexId from_begin = block_from * BLOCK_SIZE;
+            const VertexId from_end = std::min(from_begin + BLOCK_SIZE, vertex_count_);
+            const VertexId to_begin = block_to * BLOCK_SIZE;
+            const VertexId to_end = std::min(to_begin + BLOCK_SIZE, vertex_count_);
+            const VertexId through_begin = block_through * BLOCK_SIZE;
+            const VertexId through_end = std::min(through_begin + BLOCK_SIZE, vertex_count_);
+
+            TableWeight* weights = routes_internal_data_.weights.data();
+            uint32_t* prev_edges = routes_internal_data_.prev_edges.data();
+
+            for (VertexId vertex_through = through_begin; vertex_through < through_end; ++vertex_through) {
+                const size_t through_row = GetCellIndex(vertex_through, to_begin);
+                for (VertexId vertex_from = from_begin; vertex_from < from_end; ++vertex_from) {
+                    const TableWeight weight_through = weights[GetCellIndex(vertex_from, vertex_through)];
+                    if (weight_through == UNREACHABLE_WEIGHT) {
+                        continue;
                     }
+                    const size_t from_row = GetCellIndex(vertex_from, to_begin);
+                    RelaxRow(weight_through, weights + through_row, prev_edges + through_row,
+                        weights + from_row, prev_edges + from_row, to_end - to_begin);
                 }
             }
         }
 
-        static constexpr Weight ZERO_WEIGHT{};
+        //   -.      
+        //   ,      ,   .
+        //          
+        void RelaxRoutesInternalData() {
+            const size_t block_count = (vertex_count_ + BLOCK_SIZE - 1) / BLOCK_SIZE;
+            if (block_count == 0) {
+                return;
+            }
+            concurrency::ThreadPool pool;
+
+            for (size_t block_through = 0; block_through < block_count; ++block_through) {
+                RelaxBlock(block_through, block_through, block_through);
+
+                //     block_count - 1,  block_through
+                auto other_block = [block_through](size_t index) {
+                    return index < block_through ? index : index + 1;
+                };
+
+                pool.ParallelFor(2 * (block_count - 1), [&](size_t index) {
+                    const size_t block = other_block(index / 2);
+                    if (index % 2 == 0) {
+                        RelaxBlock(block_through, block, block_through);
+                    }
+                    else {
+                        RelaxBlock(block, block_through, block_through);
+                    }
+                });
+
+                pool.ParallelFor((block_count - 1) * (block_count - 1), [&](size_t index) {
+                    RelaxBlock(other_block(index / (block_count - 1)), other_block(index % (block_count - 1)), block_through);
+                });
+            }
+        }
+
+        //    ;  64 x 64   32 
+        static constexpr size_t BLOCK_SIZE = 64;
+        static constexpr TableWeight ZERO_WEIGHT{};
         const Graph& graph_;
+        size_t vertex_count_;
         RoutesInternalData routes_internal_data_;
     };
 
     template <typename Weight>
     Router<Weight>::Router(const Graph& graph)
         : graph_(graph)
-        , routes_internal_data_(graph.GetVertexCount(),
-            std::vector<std::optional<RouteInternalData>>(graph.GetVertexCount()))
+        , vertex_count_(graph.GetVertexCount())
+        , routes_internal_data_{
+            std::vector<TableWeight>(vertex_count_ * vertex_count_, UNREACHABLE_WEIGHT),
+            std::vector<uint32_t>(vertex_count_ * vertex_count_, NO_EDGE)
+        }
     {
+        if (!graph.IsFrozen()) {
+            throw std::logic_error("Graph should be frozen before routing");
+        }
         InitializeRoutesInternalData(graph);
+        RelaxRoutesInternalData();
+    }
 
-        const size_t vertex_count = graph.GetVertexCount();
-        for (VertexId vertex_through = 0; vertex_through < vertex_count; ++vertex_through) {
-            RelaxRoutesInternalDataThroughVertex(vertex_count, vertex_through);
+    template <typename Weight>
+    Router<Weight>::Router(const Graph& graph, RoutesInternalData&& routes_internal_data)
+        : graph_(graph)
+        , vertex_count_(graph.GetVertexCount())
+        , routes_internal_data_(std::move(routes_internal_data))
+    {
+        if (routes_internal_data_.weights.size() != vertex_count_ * vertex_count_
+            || routes_internal_data_.prev_edges.size() != vertex_count_ * vertex_count_) {
+            throw std::invalid_argument("Routes table doesn't match the graph");
         }
     }
 
+    template <typename Weight>
+    const typename Router<Weight>::RoutesInternalData& Router<Weight>::GetRoutesInternalData() const {
+        return routes_internal_data_;
+    }
+
+    template <typename Weight>
+    size_t Router<Weight>::GetRoutesTableMemoryUsage() const {
+        return routes_internal_data_.weights.capacity() * sizeof(TableWeight)
+            + routes_internal_data_.prev_edges.capacity() * sizeof(uint32_t);
+    }
+
     template <typename Weight>
     std::optional<typename Router<Weight>::RouteInfo> Router<Weight>::BuildRoute(VertexId from,
         VertexId to) const {
-        const auto& route_internal_data = routes_internal_data_.at(from).at(to);
-        if (!route_internal_data) {
+        if (from >= vertex_count_ || to >= vertex_count_) {
+            throw std::out_of_range("Vertex is out of graph");
+        }
+        if (routes_internal_data_.weights[GetCellIndex(from, to)] == UNREACHABLE_WEIGHT) {
             return std::nullopt;
         }
-        const Weight weight = route_internal_data->weight;
+        //       ,        
+        Weight weight{};
         std::vector<EdgeId> edges;
-        for (std::optional<EdgeId> edge_id = route_internal_data->prev_edge;
-            edge_id;
-            edge_id = routes_internal_data_[from][graph_.GetEdge(*edge_id).from]->prev_edge)
+        for (uint32_t edge_id = routes_internal_data_.prev_edges[GetCellIndex(from, to)];
+            edge_id != NO_EDGE;
+            edge_id = routes_internal_data_.prev_edges[GetCellIndex(from, graph_.GetEdge(edge_id).from)])
         {
-            edges.push_back(*edge_id);
+            edges.push_back(edge_id);
+            weight += graph_.GetEdge(edge_id).weight;
         }
         std::reverse(edges.begin(), edges.end());
 
         return RouteInfo{ weight, std::move(edges) };
     }
 
-}  // namespace graph
\ No newline at end of file
+    template <typename Weight>
+    std::optional<Weight> Router<Weight>::GetWeight(VertexId from, VertexId to) const {
+        if (from >= vertex_count_ || to >= vertex_count_) {
+            throw std::out_of_range("Vertex is out of graph");
+        }
+        const TableWeight table_weight = routes_internal_data_.weights[GetCellIndex(from, to)];
+        if (table_weight == UNREACHABLE_WEIGHT) {
+            return std::nullopt;
+        }
+        if constexpr (std::is_same_v<TableWeight, Weight>) {
+            return table_weight;
+        }
+        else {
+            //    BuildRoute,      ,    
+            Weight weight{};
+            for (uint32_t edge_id = routes_internal_data_.prev_edges[GetCellIndex(from, to)];
+                edge_id != NO_EDGE;
+                edge_id = routes_internal_data_.prev_edges[GetCellIndex(from, graph_.GetEdge(edge_id).from)])
+            {
+                weight += graph_.GetEdge(edge_id).weight;
+            }
+            return weight;
+        }
+    }
+
+}  // namespace graph
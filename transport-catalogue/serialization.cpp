@@ -10,9 +10,15 @@ namespace serialization {
 		const JSONReader::InputRequestPool& requests,
 		const renderer::RenderSettings& render_settings,
 		const router::TransportRouterSettings& router_settings,
-		const graph::DirectedWeightedGraph<double>& in_graph) {
+		const graph::DirectedWeightedGraph<router::Weight>* in_graph,
+		const std::vector<graph::VertexId>& stop_vertexes,
+		const graph::Connectivity* connectivity,
+		const graph::Router<router::Weight>* routes_table,
+		const graph::ContractionHierarchy<router::Weight>* contraction_hierarchy,
+		const graph::HubLabels<router::Weight>* hub_labels) {
 
 		catalogue_data_.Clear();
+		router_data_.Clear();
 
 		int stop_number = 0;
 		int bus_number = 0;
@@ -66,8 +72,26 @@ namespace serialization {
 		//   catalogue_data  
 		SerializeRouterSettings(router_settings);
 
-		//  
-		SerializeGraph(in_graph);
+		//  . RAPTOR    :      
+		if (in_graph) {
+			SerializeGraph(*in_graph);
+			SerializeStopVertexes(stop_vertexes);
+		}
+		if (connectivity) {
+			SerializeComponents(*connectivity);
+		}
+
+		//     ,      process_requests
+		if (routes_table) {
+			SerializeRoutesTable(*routes_table, in_graph->GetVertexCount());
+		}
+		//     
+		if (contraction_hierarchy) {
+			SerializeContractionHierarchy(*contraction_hierarchy);
+		}
+		if (hub_labels) {
+			SerializeHubLabels(*hub_labels);
+		}
 
 		//    
 		std::ofstream out(file_, std::ios::binary);
@@ -75,7 +99,12 @@ namespace serialization {
 			return;
 		}
 		
-		catalogue_data_.SerializeToOstream(&out);
+		//      ,      
+		const std::string catalogue_bytes = catalogue_data_.SerializeAsString();
+		const uint64_t catalogue_size = catalogue_bytes.size();
+		out.write(reinterpret_cast<const char*>(&catalogue_size), sizeof(catalogue_size));
+		out.write(catalogue_bytes.data(), catalogue_bytes.size());
+		router_data_.SerializeToOstream(&out);
 	}
 
 	DeserializedData TransportCatalogueSerializer::DeserializeTransportCatalogue() {
@@ -84,8 +113,13 @@ namespace serialization {
 
 		std::ifstream in(file_, std::ios::binary);
 		
-		//    
-		catalogue_data_.ParseFromIstream(&in);
+		//      ,   -    DeserializeRouterData
+		uint64_t catalogue_size = 0;
+		in.read(reinterpret_cast<char*>(&catalogue_size), sizeof(catalogue_size));
+		std::string catalogue_bytes(catalogue_size, '\0');
+		in.read(catalogue_bytes.data(), catalogue_size);
+		catalogue_data_.ParseFromString(catalogue_bytes);
+		router_data_offset_ = sizeof(catalogue_size) + catalogue_size;
 
 		//  
 		int stop_num = 0;
@@ -131,9 +165,28 @@ namespace serialization {
 		return {
 			result,
 			std::move(DeserializeRenderSettings()),
-			std::move(DeserializeRouterSettings()),
-			std::move(DeserializeGraph())
+			std::move(DeserializeRouterSettings())
+		};
+	}
+
+	DeserializedRouterData TransportCatalogueSerializer::DeserializeRouterData() {
+		router_data_.Clear();
+
+		std::ifstream in(file_, std::ios::binary);
+		in.seekg(router_data_offset_);
+		router_data_.ParseFromIstream(&in);
+
+		DeserializedRouterData result{
+			DeserializeGraph(),
+			router::PrecomputedRouterData{ DeserializeRoutesTable(), DeserializeContractionHierarchy(), DeserializeStopVertexes(),
+				DeserializeHubLabels(), DeserializeComponents(),
+				static_cast<int>(catalogue_data_.router_settings_().bus_wait_time_()),
+				static_cast<int>(catalogue_data_.router_settings_().bus_velocity_()) }
 		};
+		//     ,    
+		router_data_.Clear();
+
+		return result;
 	}
 
 	transport_catalogue_serialize::Color TransportCatalogueSerializer::ConvertToSerializeColor(svg::Color input_color) const {
@@ -266,6 +319,32 @@ namespace serialization {
 
 		out_settings.set_bus_velocity_(settings.bus_velocity_);
 		out_settings.set_bus_wait_time_(settings.bus_wait_time_);
+		switch (settings.router_type_) {
+		case router::RouterType::ALL_PAIRS:
+			out_settings.set_router_type_(transport_catalogue_serialize::ALL_PAIRS);
+			break;
+		case router::RouterType::CONTRACTION_HIERARCHIES:
+			out_settings.set_router_type_(transport_catalogue_serialize::CONTRACTION_HIERARCHIES);
+			break;
+		case router::RouterType::A_STAR:
+			out_settings.set_router_type_(transport_catalogue_serialize::A_STAR);
+			break;
+		case router::RouterType::RAPTOR:
+			out_settings.set_router_type_(transport_catalogue_serialize::RAPTOR);
+			break;
+		case router::RouterType::DIJKSTRA:
+			out_settings.set_router_type_(transport_catalogue_serialize::DIJKSTRA);
+			break;
+		}
+		out_settings.set_memory_report_(settings.memory_report_);
+		out_settings.set_route_cache_capacity_(static_cast<uint32_t>(settings.route_cache_capacity_));
+		out_settings.set_hub_labels_(settings.hub_labels_);
+		out_settings.set_graph_model_(settings.graph_model_ == router::GraphModel::LINEAR
+			? transport_catalogue_serialize::LINEAR
+			: transport_catalogue_serialize::COMPLETE);
+		out_settings.set_vertex_order_(settings.vertex_order_ == router::VertexOrder::REVERSE_CUTHILL_MCKEE
+			? transport_catalogue_serialize::REVERSE_CUTHILL_MCKEE
+			: transport_catalogue_serialize::CREATION_ORDER);
 
 		*catalogue_data_.mutable_router_settings_() = out_settings;
 	}
@@ -276,12 +355,38 @@ namespace serialization {
 
 		out_settings.bus_velocity_ = in_settings.bus_velocity_();
 		out_settings.bus_wait_time_ = in_settings.bus_wait_time_();
+		switch (in_settings.router_type_()) {
+		case transport_catalogue_serialize::ALL_PAIRS:
+			out_settings.router_type_ = router::RouterType::ALL_PAIRS;
+			break;
+		case transport_catalogue_serialize::CONTRACTION_HIERARCHIES:
+			out_settings.router_type_ = router::RouterType::CONTRACTION_HIERARCHIES;
+			break;
+		case transport_catalogue_serialize::A_STAR:
+			out_settings.router_type_ = router::RouterType::A_STAR;
+			break;
+		case transport_catalogue_serialize::RAPTOR:
+			out_settings.router_type_ = router::RouterType::RAPTOR;
+			break;
+		default:
+			out_settings.router_type_ = router::RouterType::DIJKSTRA;
+			break;
+		}
+		out_settings.memory_report_ = in_settings.memory_report_();
+		out_settings.route_cache_capacity_ = in_settings.route_cache_capacity_();
+		out_settings.hub_labels_ = in_settings.hub_labels_();
+		out_settings.graph_model_ = in_settings.graph_model_() == transport_catalogue_serialize::LINEAR
+			? router::GraphModel::LINEAR
+			: router::GraphModel::COMPLETE;
+		out_settings.vertex_order_ = in_settings.vertex_order_() == transport_catalogue_serialize::REVERSE_CUTHILL_MCKEE
+			? router::VertexOrder::REVERSE_CUTHILL_MCKEE
+			: router::VertexOrder::CREATION;
 
 		return out_settings;
 	}
 
 	// /   
-	void TransportCatalogueSerializer::SerializeGraph(const graph::DirectedWeightedGraph<double>& in_graph) {
+	void TransportCatalogueSerializer::SerializeGraph(const graph::DirectedWeightedGraph<router::Weight>& in_graph) {
 
 		transport_catalogue_serialize::DirectedWeightedGraph out_graph;
 
@@ -291,71 +396,261 @@ namespace serialization {
 		for (const auto& edge : edges) {
 			transport_catalogue_serialize::Edge* new_edge = out_graph.add_edges_();
 
-			transport_catalogue_serialize::EdgeBusInfo bus_info;
-			if (edge.info.has_value()) {
-				bus_info.set_stops_count_(edge.info.value().second);
-				bus_info.set_bus_number_(bus_name_to_number_.at(edge.info.value().first));
-				*new_edge->mutable_info_() = bus_info;
+			const graph::EdgeInfo& edge_info = in_graph.GetEdgeInfo(edge_id);
+			if (edge_info.HasBus()) {
+				transport_catalogue_serialize::EdgeBusInfo* bus_info = new_edge->mutable_info_();
+				bus_info->set_stops_count_(edge_info.span_count);
+				bus_info->set_bus_number_(edge_info.bus_id);
+				bus_info->set_distance_(edge_info.distance);
 			}
 			
 			new_edge->set_edge_id_(edge_id);
-			new_edge->set_weight_(edge.weight);
 			new_edge->set_from_(edge.from);
 			new_edge->set_to_(edge.to);
 			
 			++edge_id;
 		}
 
-		const auto& vertexex = in_graph.GetVertexes();
+		//     :       
+		out_graph.set_vertex_count_(in_graph.GetVertexCount());
 
-		for (int vertex_num = 0; vertex_num < vertexex.size(); ++vertex_num) {
-			transport_catalogue_serialize::Vertex* new_vertex = out_graph.add_incidence_lists_();
-			//     vertex_num
-			*new_vertex->mutable_edge_id_() = { vertexex[vertex_num].begin(), vertexex[vertex_num].end() };
-			new_vertex->set_vertex_id_(vertex_num);
-		}
-
- 		*catalogue_data_.mutable_graph_()->mutable_graph_() = out_graph;
+ 		*router_data_.mutable_graph_()->mutable_graph_() = out_graph;
 	}
 
-	graph::DirectedWeightedGraph<double> TransportCatalogueSerializer::DeserializeGraph() {
+	graph::DirectedWeightedGraph<router::Weight> TransportCatalogueSerializer::DeserializeGraph() {
+		if (!router_data_.has_graph_()) {
+			return {};
+		}
 
-		transport_catalogue_serialize::DirectedWeightedGraph in_graph = catalogue_data_.graph_().graph_();
-		graph::DirectedWeightedGraph<double> out_graph;
+		const transport_catalogue_serialize::DirectedWeightedGraph& in_graph = router_data_.graph_().graph_();
+		graph::DirectedWeightedGraph<router::Weight> out_graph(in_graph.vertex_count_());
 
 		//   
 		const auto& edges = in_graph.edges_();
 		auto& new_edges = out_graph.GetEdges();			
+		auto& new_edge_infos = out_graph.GetEdgeInfos();
+		new_edges.reserve(edges.size());
+		new_edge_infos.reserve(edges.size());
 
 		for (const auto& edge : edges) {
-			graph::EdgeInfo bus_info = std::nullopt;
+			graph::EdgeInfo bus_info;
 			if (edge.has_info_()) {
-				
-				bus_info = {
-					number_to_bus_name_.at(edge.info_().bus_number_()),
-					edge.info_().stops_count_() 
-				};
+				bus_info.bus_id = edge.info_().bus_number_();
+				bus_info.span_count = edge.info_().stops_count_();
+				bus_info.distance = edge.info_().distance_();
 			}
 			
 			new_edges.push_back({
 				edge.from_(),
 				edge.to_(),
-				edge.weight_(),
-				bus_info
+				//        
+				router::Weight{}
 			});
+			new_edge_infos.push_back(bus_info);
 		}
-			
-		const auto& vertexes = in_graph.incidence_lists_();
-		auto& new_vertexes = out_graph.GetVertexes();
-		new_vertexes.resize(in_graph.incidence_lists_().size());
 
-		for (const auto& vertex : vertexes) {
-			for (const auto& id : vertex.edge_id_()) {
-				new_vertexes[vertex.vertex_id_()].emplace_back(id);
-			}			
-		}
+		out_graph.Freeze();
 
 		return out_graph;
 	}
 
+	void TransportCatalogueSerializer::SerializeStopVertexes(const std::vector<graph::VertexId>& stop_vertexes) {
+		auto* out_stop_vertexes = router_data_.mutable_graph_()->mutable_id_to_stop_number_();
+		out_stop_vertexes->Reserve(static_cast<int>(stop_vertexes.size()));
+		for (size_t stop_number = 0; stop_number < stop_vertexes.size(); ++stop_number) {
+			transport_catalogue_serialize::IdToStop* id_to_stop = out_stop_vertexes->Add();
+			id_to_stop->set_id_in_graph(static_cast<uint32_t>(stop_vertexes[stop_number]));
+			id_to_stop->set_stop_number_(static_cast<uint32_t>(stop_number));
+		}
+	}
+
+	std::vector<graph::VertexId> TransportCatalogueSerializer::DeserializeStopVertexes() {
+		const auto& in_stop_vertexes = router_data_.graph_().id_to_stop_number_();
+		std::vector<graph::VertexId> stop_vertexes(in_stop_vertexes.size());
+		for (const auto& id_to_stop : in_stop_vertexes) {
+			stop_vertexes.at(id_to_stop.stop_number_()) = id_to_stop.id_in_graph();
+		}
+
+		return stop_vertexes;
+	}
+
+	void TransportCatalogueSerializer::SerializeComponents(const graph::Connectivity& connectivity) {
+		const auto& components = connectivity.GetComponentsData();
+		transport_catalogue_serialize::GraphComponents* out_components = router_data_.mutable_components_();
+		*out_components->mutable_strong_component_() = { components.strong_components.begin(), components.strong_components.end() };
+		*out_components->mutable_weak_component_() = { components.weak_components.begin(), components.weak_components.end() };
+	}
+
+	std::optional<graph::Connectivity::ComponentsData> TransportCatalogueSerializer::DeserializeComponents() {
+		//  ,    ,  :    
+		if (!router_data_.has_components_()) {
+			return std::nullopt;
+		}
+
+		const transport_catalogue_serialize::GraphComponents& in_components = router_data_.components_();
+		return graph::Connectivity::ComponentsData{
+			{ in_components.strong_component_().begin(), in_components.strong_component_().end() },
+			{ in_components.weak_component_().begin(), in_components.weak_component_().end() }
+		};
+	}
+
+	void TransportCatalogueSerializer::SerializeRoutesTable(const graph::Router<router::Weight>& routes_table, size_t vertex_count) {
+		using RoutesTable = graph::Router<router::Weight>;
+		const auto& routes_data = routes_table.GetRoutesInternalData();
+		transport_catalogue_serialize::RoutesTable* out_table = router_data_.mutable_routes_table_();
+
+		out_table->set_vertex_count_(vertex_count);
+		if constexpr (std::is_integral_v<RoutesTable::TableWeight>) {
+			*out_table->mutable_fixed_weight_() = { routes_data.weights.begin(), routes_data.weights.end() };
+		}
+		else {
+			*out_table->mutable_weight_() = { routes_data.weights.begin(), routes_data.weights.end() };
+		}
+		out_table->mutable_prev_edge_()->Reserve(routes_data.prev_edges.size());
+		for (const uint32_t prev_edge : routes_data.prev_edges) {
+			//   , . transport_router.proto
+			out_table->add_prev_edge_(prev_edge == RoutesTable::NO_EDGE ? 0 : prev_edge + 1);
+		}
+	}
+
+	std::optional<graph::Router<router::Weight>::RoutesInternalData> TransportCatalogueSerializer::DeserializeRoutesTable() {
+		using RoutesTable = graph::Router<router::Weight>;
+		if (!router_data_.has_routes_table_()) {
+			return std::nullopt;
+		}
+
+		const transport_catalogue_serialize::RoutesTable& in_table = router_data_.routes_table_();
+		const size_t cell_count = static_cast<size_t>(in_table.vertex_count_()) * in_table.vertex_count_();
+		const auto& in_weights = [&in_table]() -> const auto& {
+			if constexpr (std::is_integral_v<RoutesTable::TableWeight>) {
+				return in_table.fixed_weight_();
+			}
+			else {
+				return in_table.weight_();
+			}
+		}();
+		// ,     ,  :    
+		if (static_cast<size_t>(in_weights.size()) != cell_count
+			|| static_cast<size_t>(in_table.prev_edge__size()) != cell_count) {
+			return std::nullopt;
+		}
+
+		RoutesTable::RoutesInternalData routes_data;
+		routes_data.weights.assign(in_weights.begin(), in_weights.end());
+		routes_data.prev_edges.reserve(cell_count);
+		for (const uint32_t prev_edge : in_table.prev_edge_()) {
+			routes_data.prev_edges.push_back(prev_edge == 0 ? RoutesTable::NO_EDGE : prev_edge - 1);
+		}
+
+		return routes_data;
+	}
+
+	void TransportCatalogueSerializer::SerializeContractionHierarchy(const graph::ContractionHierarchy<router::Weight>& contraction_hierarchy) {
+		const auto& hierarchy = contraction_hierarchy.GetHierarchyData();
+		transport_catalogue_serialize::ContractionHierarchy* out_hierarchy = router_data_.mutable_contraction_hierarchy_();
+
+		*out_hierarchy->mutable_rank_() = { hierarchy.ranks.begin(), hierarchy.ranks.end() };
+		for (const auto& shortcut : hierarchy.shortcuts) {
+			out_hierarchy->add_shortcut_from_(shortcut.from);
+			out_hierarchy->add_shortcut_to_(shortcut.to);
+			if constexpr (std::is_integral_v<router::Weight>) {
+				out_hierarchy->add_fixed_shortcut_weight_(shortcut.weight);
+			}
+			else {
+				out_hierarchy->add_shortcut_weight_(shortcut.weight);
+			}
+			out_hierarchy->add_shortcut_first_edge_(shortcut.first_edge);
+			out_hierarchy->add_shortcut_second_edge_(shortcut.second_edge);
+		}
+	}
+
+	std::optional<graph::ContractionHierarchy<router::Weight>::HierarchyData> TransportCatalogueSerializer::DeserializeContractionHierarchy() {
+		if (!router_data_.has_contraction_hierarchy_()) {
+			return std::nullopt;
+		}
+
+		const transport_catalogue_serialize::ContractionHierarchy& in_hierarchy = router_data_.contraction_hierarchy_();
+		const int shortcut_count = in_hierarchy.shortcut_from__size();
+		const auto& in_weights = [&in_hierarchy]() -> const auto& {
+			if constexpr (std::is_integral_v<router::Weight>) {
+				return in_hierarchy.fixed_shortcut_weight_();
+			}
+			else {
+				return in_hierarchy.shortcut_weight_();
+			}
+		}();
+		// ,     ,  :    
+		if (in_hierarchy.shortcut_to__size() != shortcut_count
+			|| in_weights.size() != shortcut_count
+			|| in_hierarchy.shortcut_first_edge__size() != shortcut_count
+			|| in_hierarchy.shortcut_second_edge__size() != shortcut_count) {
+			return std::nullopt;
+		}
+
+		graph::ContractionHierarchy<router::Weight>::HierarchyData hierarchy;
+		hierarchy.ranks.assign(in_hierarchy.rank_().begin(), in_hierarchy.rank_().end());
+		hierarchy.shortcuts.reserve(shortcut_count);
+		for (int i = 0; i < shortcut_count; ++i) {
+			hierarchy.shortcuts.push_back({
+				in_hierarchy.shortcut_from_(i),
+				in_hierarchy.shortcut_to_(i),
+				static_cast<router::Weight>(in_weights.Get(i)),
+				in_hierarchy.shortcut_first_edge_(i),
+				in_hierarchy.shortcut_second_edge_(i)
+			});
+		}
+
+		return hierarchy;
+	}
+
+	void TransportCatalogueSerializer::SerializeHubLabels(const graph::HubLabels<router::Weight>& hub_labels) {
+		const auto& labels_data = hub_labels.GetLabelsData();
+		SerializeLabels(labels_data.forward, *router_data_.mutable_forward_hub_labels_());
+		SerializeLabels(labels_data.backward, *router_data_.mutable_backward_hub_labels_());
+	}
+
+	void TransportCatalogueSerializer::SerializeLabels(const graph::HubLabels<router::Weight>::Labels& labels,
+		transport_catalogue_serialize::HubLabels& out_labels) {
+		*out_labels.mutable_offset_() = { labels.offsets.begin(), labels.offsets.end() };
+		*out_labels.mutable_hub_() = { labels.hubs.begin(), labels.hubs.end() };
+		if constexpr (std::is_integral_v<router::Weight>) {
+			*out_labels.mutable_fixed_distance_() = { labels.distances.begin(), labels.distances.end() };
+		}
+		else {
+			*out_labels.mutable_distance_() = { labels.distances.begin(), labels.distances.end() };
+		}
+	}
+
+	std::optional<graph::HubLabels<router::Weight>::LabelsData> TransportCatalogueSerializer::DeserializeHubLabels() {
+		if (!router_data_.has_forward_hub_labels_() || !router_data_.has_backward_hub_labels_()) {
+			return std::nullopt;
+		}
+
+		graph::HubLabels<router::Weight>::LabelsData labels_data{
+			DeserializeLabels(router_data_.forward_hub_labels_()),
+			DeserializeLabels(router_data_.backward_hub_labels_())
+		};
+		// ,     ,  :    
+		if (labels_data.forward.distances.size() != labels_data.forward.hubs.size()
+			|| labels_data.backward.distances.size() != labels_data.backward.hubs.size()) {
+			return std::nullopt;
+		}
+
+		return labels_data;
+	}
+
+	graph::HubLabels<router::Weight>::Labels TransportCatalogueSerializer::DeserializeLabels(
+		const transport_catalogue_serialize::HubLabels& in_labels) {
+		graph::HubLabels<router::Weight>::Labels labels;
+		labels.offsets.assign(in_labels.offset_().begin(), in_labels.offset_().end());
+		labels.hubs.assign(in_labels.hub_().begin(), in_labels.hub_().end());
+		if constexpr (std::is_integral_v<router::Weight>) {
+			labels.distances.assign(in_labels.fixed_distance_().begin(), in_labels.fixed_distance_().end());
+		}
+		else {
+			labels.distances.assign(in_labels.distance_().begin(), in_labels.distance_().end());
+		}
+		return labels;
+	}
+
 } // namespace serialization
@@ -7,6 +7,8 @@
 #include <iostream>
 #include <vector>
 #include <tuple>
+#include <type_traits>
+#include <utility>
 
 #include "include/transport_catalogue.pb.h"
 #include "json_reader.h"
@@ -19,8 +21,12 @@ namespace serialization {
 	using DeserializedData = std::tuple<
 		JSONReader::InputRequestPool,
 		renderer::RenderSettings, 
-		router::TransportRouterSettings,
-		graph::DirectedWeightedGraph<double>>;
+		router::TransportRouterSettings>;
+
+	//     make_base  
+	using DeserializedRouterData = std::pair<
+		graph::DirectedWeightedGraph<router::Weight>,
+		router::PrecomputedRouterData>;
 
 	class TransportCatalogueSerializer {
 	public:
@@ -31,12 +37,24 @@ namespace serialization {
 			const JSONReader::InputRequestPool& requests,
 			const renderer::RenderSettings& render_settings,
 			const router::TransportRouterSettings& router_settings,
-			const graph::DirectedWeightedGraph<double>& in_graph
+			const graph::DirectedWeightedGraph<router::Weight>* in_graph,
+			const std::vector<graph::VertexId>& stop_vertexes,
+			const graph::Connectivity* connectivity,
+			const graph::Router<router::Weight>* routes_table = nullptr,
+			const graph::ContractionHierarchy<router::Weight>* contraction_hierarchy = nullptr,
+			const graph::HubLabels<router::Weight>* hub_labels = nullptr
 		);
 		DeserializedData DeserializeTransportCatalogue();
+		//     .   DeserializeTransportCatalogue,
+		//       .    ,
+		//    
+		DeserializedRouterData DeserializeRouterData();
 	private:
 		Path file_;
 		transport_catalogue_serialize::TransportCatalogue catalogue_data_;	
+		transport_catalogue_serialize::RouterData router_data_;
+		//      
+		std::streamoff router_data_offset_ = 0;
 		//    /  / 
 		std::unordered_map<int, std::string_view> number_to_stop_name_;
 		std::unordered_map<std::string_view, int> stop_name_to_number_;
@@ -57,7 +75,31 @@ namespace serialization {
 		router::TransportRouterSettings DeserializeRouterSettings();
 
 		// /   
-		void SerializeGraph(const graph::DirectedWeightedGraph<double>& in_graph);
-		graph::DirectedWeightedGraph<double> DeserializeGraph();
+		void SerializeGraph(const graph::DirectedWeightedGraph<router::Weight>& in_graph);
+		graph::DirectedWeightedGraph<router::Weight> DeserializeGraph();
+
+		// /   .
+		//          :     
+		void SerializeStopVertexes(const std::vector<graph::VertexId>& stop_vertexes);
+		std::vector<graph::VertexId> DeserializeStopVertexes();
+
+		// /   
+		void SerializeComponents(const graph::Connectivity& connectivity);
+		std::optional<graph::Connectivity::ComponentsData> DeserializeComponents();
+
+		// /       
+		void SerializeRoutesTable(const graph::Router<router::Weight>& routes_table, size_t vertex_count);
+		std::optional<graph::Router<router::Weight>::RoutesInternalData> DeserializeRoutesTable();
+
+		// /    
+		void SerializeContractionHierarchy(const graph::ContractionHierarchy<router::Weight>& contraction_hierarchy);
+		std::optional<graph::ContractionHierarchy<router::Weight>::HierarchyData> DeserializeContractionHierarchy();
+
+		// /  
+		void SerializeHubLabels(const graph::HubLabels<router::Weight>& hub_labels);
+		std::optional<graph::HubLabels<router::Weight>::LabelsData> DeserializeHubLabels();
+		static void SerializeLabels(const graph::HubLabels<router::Weight>::Labels& labels,
+			transport_catalogue_serialize::HubLabels& out_labels);
+		static graph::HubLabels<router::Weight>::Labels DeserializeLabels(const transport_catalogue_serialize::HubLabels& in_labels);
 	};
 } // namespace serialization
@@ -1,8 +1,13 @@
 #include "../request_handler.h"
 #include "log_duration.h"
 
+#include <cassert>
+#include <cmath>
 #include <iostream>
+#include <sstream>
 #include <string>
+#include <utility>
+#include <vector>
 
 using namespace std::literals;
 
@@ -48,4 +53,207 @@ namespace tests {
 		}*/
 	}
 
+	//             
+	//   ,          
+	void test1() {
+		const std::string make_base = R"({
+			"serialization_settings": { "file": "test1.db" },
+			"routing_settings": { "bus_wait_time": 6, "bus_velocity": 40, "graph_model": "complete" },
+			"render_settings": {
+				"width": 600, "height": 400, "padding": 50, "stop_radius": 5, "line_width": 14,
+				"bus_label_font_size": 20, "bus_label_offset": [7, 15],
+				"stop_label_font_size": 20, "stop_label_offset": [7, -3],
+				"underlayer_color": [255, 255, 255, 0.85], "underlayer_width": 3, "color_palette": ["green"]
+			},
+			"base_requests": [
+				{ "type": "Bus", "name": "1", "stops": ["A", "B", "C", "D"], "is_roundtrip": false },
+				{ "type": "Bus", "name": "2", "stops": ["A", "C", "D"], "is_roundtrip": false },
+				{ "type": "Stop", "name": "A", "latitude": 55.60, "longitude": 37.60, "road_distances": { "B": 1000, "C": 2500 } },
+				{ "type": "Stop", "name": "B", "latitude": 55.61, "longitude": 37.60, "road_distances": { "C": 1000 } },
+				{ "type": "Stop", "name": "C", "latitude": 55.62, "longitude": 37.60, "road_distances": { "D": 1000 } },
+				{ "type": "Stop", "name": "D", "latitude": 55.63, "longitude": 37.60, "road_distances": {} }
+			]
+		})";
+		const std::string process_requests = R"({
+			"serialization_settings": { "file": "test1.db" },
+			"stat_requests": [
+				{ "id": 1, "type": "Route", "from": "A", "to": "D", "alternatives": 8 },
+				{ "id": 2, "type": "Route", "from": "D", "to": "A", "alternatives": 8 }
+			]
+		})";
+		{
+			Catalogue::TransportCatalogue catalogue;
+			RqstHandler::RequestHandler handler(catalogue);
+			std::istringstream input(make_base);
+			handler.MakeBase(input);
+		}
+		std::stringstream out;
+		{
+			Catalogue::TransportCatalogue catalogue;
+			RqstHandler::RequestHandler handler(catalogue);
+			std::istringstream input(process_requests);
+			handler.ProcessRequests(input, out);
+		}
+
+		const json::Document answers = json::Load(out);
+		for (const json::Node& answer : answers.GetRoot().AsArray()) {
+			const json::Array& routes = answer.AsDict().at("routes"s).AsArray();
+			//    1  2    
+			assert(routes.size() >= 3);
+			for (const json::Node& route : routes) {
+				std::string previous_bus;
+				for (const json::Node& item : route.AsDict().at("items"s).AsArray()) {
+					const json::Dict& item_data = item.AsDict();
+					if (item_data.at("type"s).AsString() != "Bus"s) {
+						continue;
+					}
+					const std::string& bus = item_data.at("bus"s).AsString();
+					assert(bus != previous_bus);
+					previous_bus = bus;
+				}
+			}
+		}
+	}
+
+	//         total_time    Route
+	//    ,    -   "not found"
+	void test2() {
+		const std::vector<std::string> from = { "A"s, "C"s, "F"s };
+		const std::vector<std::string> to = { "A"s, "D"s, "E"s, "F"s };
+		for (const std::string graph_model : { "complete"s, "linear"s }) {
+			const std::string make_base = R"({
+				"serialization_settings": { "file": "test2.db" },
+				"routing_settings": { "bus_wait_time": 6, "bus_velocity": 40, "graph_model": ")" + graph_model + R"(" },
+				"render_settings": {
+					"width": 600, "height": 400, "padding": 50, "stop_radius": 5, "line_width": 14,
+					"bus_label_font_size": 20, "bus_label_offset": [7, 15],
+					"stop_label_font_size": 20, "stop_label_offset": [7, -3],
+					"underlayer_color": [255, 255, 255, 0.85], "underlayer_width": 3, "color_palette": ["green"]
+				},
+				"base_requests": [
+					{ "type": "Bus", "name": "1", "stops": ["A", "B", "C", "D"], "is_roundtrip": false },
+					{ "type": "Bus", "name": "2", "stops": ["C", "E"], "is_roundtrip": false },
+					{ "type": "Stop", "name": "A", "latitude": 55.60, "longitude": 37.60, "road_distances": { "B": 1000 } },
+					{ "type": "Stop", "name": "B", "latitude": 55.61, "longitude": 37.60, "road_distances": { "C": 1500 } },
+					{ "type": "Stop", "name": "C", "latitude": 55.62, "longitude": 37.60, "road_distances": { "D": 1000, "E": 2000 } },
+					{ "type": "Stop", "name": "D", "latitude": 55.63, "longitude": 37.60, "road_distances": {} },
+					{ "type": "Stop", "name": "E", "latitude": 55.62, "longitude": 37.62, "road_distances": {} },
+					{ "type": "Stop", "name": "F", "latitude": 55.64, "longitude": 37.64, "road_distances": {} }
+				]
+			})";
+			//   - ,    Route      
+			std::string process_requests = R"({
+				"serialization_settings": { "file": "test2.db" },
+				"stat_requests": [
+					{ "id": 0, "type": "Matrix", "from": ["A", "C", "F"], "to": ["A", "D", "E", "F"] })";
+			int id = 1;
+			for (const std::string& from_stop : from) {
+				for (const std::string& to_stop : to) {
+					process_requests += R"(, { "id": )" + std::to_string(id++) + R"(, "type": "Route", "from": ")"
+						+ from_stop + R"(", "to": ")" + to_stop + R"(" })";
+				}
+			}
+			process_requests += "] }"s;
+			{
+				Catalogue::TransportCatalogue catalogue;
+				RqstHandler::RequestHandler handler(catalogue);
+				std::istringstream input(make_base);
+				handler.MakeBase(input);
+			}
+			std::stringstream out;
+			{
+				Catalogue::TransportCatalogue catalogue;
+				RqstHandler::RequestHandler handler(catalogue);
+				std::istringstream input(process_requests);
+				handler.ProcessRequests(input, out);
+			}
+
+			const json::Document answers = json::Load(out);
+			const json::Array& answer_array = answers.GetRoot().AsArray();
+			assert(answer_array.size() == 1 + from.size() * to.size());
+			const json::Array& times = answer_array[0].AsDict().at("times"s).AsArray();
+			assert(times.size() == from.size());
+			size_t index = 1;
+			for (const json::Node& row : times) {
+				assert(row.AsArray().size() == to.size());
+				for (const json::Node& time : row.AsArray()) {
+					const json::Dict& route = answer_array[index++].AsDict();
+					if (time.IsNull()) {
+						assert(route.count("error_message"s));
+					}
+					else {
+						assert(std::abs(time.AsDouble() - route.at("total_time"s).AsDouble()) < 1e-6);
+					}
+				}
+			}
+		}
+	}
+
+	//  Reachable        max_time,  ,
+	//     max_time  "not found"   
+	void test3() {
+		//   A: B - 7.5 ( 6  1000    40 /), C - 9.75, D - 11.25
+		const std::vector<std::pair<std::string, double>> expected_all = {
+			{ "A"s, 0.0 }, { "B"s, 7.5 }, { "C"s, 9.75 }, { "D"s, 11.25 }
+		};
+		for (const std::string graph_model : { "complete"s, "linear"s }) {
+			const std::string make_base = R"({
+				"serialization_settings": { "file": "test3.db" },
+				"routing_settings": { "bus_wait_time": 6, "bus_velocity": 40, "graph_model": ")" + graph_model + R"(" },
+				"render_settings": {
+					"width": 600, "height": 400, "padding": 50, "stop_radius": 5, "line_width": 14,
+					"bus_label_font_size": 20, "bus_label_offset": [7, 15],
+					"stop_label_font_size": 20, "stop_label_offset": [7, -3],
+					"underlayer_color": [255, 255, 255, 0.85], "underlayer_width": 3, "color_palette": ["green"]
+				},
+				"base_requests": [
+					{ "type": "Bus", "name": "1", "stops": ["A", "B", "C", "D"], "is_roundtrip": false },
+					{ "type": "Stop", "name": "A", "latitude": 55.60, "longitude": 37.60, "road_distances": { "B": 1000 } },
+					{ "type": "Stop", "name": "B", "latitude": 55.61, "longitude": 37.60, "road_distances": { "C": 1500 } },
+					{ "type": "Stop", "name": "C", "latitude": 55.62, "longitude": 37.60, "road_distances": { "D": 1000 } },
+					{ "type": "Stop", "name": "D", "latitude": 55.63, "longitude": 37.60, "road_distances": {} }
+				]
+			})";
+			const std::string process_requests = R"({
+				"serialization_settings": { "file": "test3.db" },
+				"stat_requests": [
+					{ "id": 1, "type": "Reachable", "from": "A", "max_time": 10 },
+					{ "id": 2, "type": "Reachable", "from": "A", "max_time": 7.5 },
+					{ "id": 3, "type": "Reachable", "from": "A", "max_time": 0 },
+					{ "id": 4, "type": "Reachable", "from": "A", "max_time": -1 },
+					{ "id": 5, "type": "Reachable", "from": "A", "max_time": 1000 },
+					{ "id": 6, "type": "Reachable", "from": "Z", "max_time": 10 }
+				]
+			})";
+			{
+				Catalogue::TransportCatalogue catalogue;
+				RqstHandler::RequestHandler handler(catalogue);
+				std::istringstream input(make_base);
+				handler.MakeBase(input);
+			}
+			std::stringstream out;
+			{
+				Catalogue::TransportCatalogue catalogue;
+				RqstHandler::RequestHandler handler(catalogue);
+				std::istringstream input(process_requests);
+				handler.ProcessRequests(input, out);
+			}
+
+			const json::Document answers = json::Load(out);
+			const json::Array& answer_array = answers.GetRoot().AsArray();
+			//     expected_all          
+			const std::vector<size_t> expected_counts = { 3, 2, 1, 0, 4 };
+			for (size_t index = 0; index < expected_counts.size(); ++index) {
+				const json::Array& stops = answer_array[index].AsDict().at("stops"s).AsArray();
+				assert(stops.size() == expected_counts[index]);
+				for (size_t i = 0; i < stops.size(); ++i) {
+					const json::Dict& stop = stops[i].AsDict();
+					assert(stop.at("stop_name"s).AsString() == expected_all[i].first);
+					assert(std::abs(stop.at("time"s).AsDouble() - expected_all[i].second) < 1e-6);
+				}
+			}
+			assert(answer_array[5].AsDict().at("error_message"s).AsString() == "not found"s);
+		}
+	}
+
 } // namespace tests
@@ -0,0 +1,55 @@
+#include "thread_pool.h"
+
+namespace concurrency {
+
+	ThreadPool::ThreadPool(size_t thread_count) {
+		if (thread_count == 0) {
+			thread_count = std::max(1u, std::thread::hardware_concurrency());
+		}
+		// Один из потоков - вызывающий ParallelFor, поэтому фоновых на один меньше
+		workers_.reserve(thread_count - 1);
+		for (size_t i = 1; i < thread_count; ++i) {
+			workers_.emplace_back([this]() { WorkerLoop(); });
+		}
+	}
+
+	ThreadPool::~ThreadPool() {
+		{
+			std::lock_guard guard(mutex_);
+			stopping_ = true;
+		}
+		tasks_cv_.notify_all();
+		for (auto& worker : workers_) {
+			worker.join();
+		}
+	}
+
+	size_t ThreadPool::GetThreadCount() const {
+		return workers_.size() + 1;
+	}
+
+	void ThreadPool::Submit(std::function<void()> task) {
+		{
+			std::lock_guard guard(mutex_);
+			tasks_.push_back(std::move(task));
+		}
+		tasks_cv_.notify_one();
+	}
+
+	void ThreadPool::WorkerLoop() {
+		while (true) {
+			std::function<void()> task;
+			{
+				std::unique_lock lock(mutex_);
+				tasks_cv_.wait(lock, [this]() { return stopping_ || !tasks_.empty(); });
+				if (tasks_.empty()) {
+					return;
+				}
+				task = std::move(tasks_.front());
+				tasks_.pop_front();
+			}
+			task();
+		}
+	}
+
+} // namespace concurrency
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace concurrency {
+
+	// Пул потоков фиксированного размера
+	class ThreadPool {
+	public:
+		// При thread_count == 0 создаётся по потоку на каждое ядро
+		explicit ThreadPool(size_t thread_count = 0);
+		~ThreadPool();
+
+		ThreadPool(const ThreadPool&) = delete;
+		ThreadPool& operator=(const ThreadPool&) = delete;
+
+		// Кол-во потоков, выполняющих работу, включая вызывающий ParallelFor поток
+		size_t GetThreadCount() const;
+
+		// Вызывает func(index) для всех index из [0, count) и дожидается завершения всех вызовов.
+		// Вызывающий поток тоже участвует в работе. Первое выброшенное исключение пробрасывается наружу
+		template <typename Func>
+		void ParallelFor(size_t count, const Func& func);
+
+	private:
+		std::vector<std::thread> workers_;
+		std::deque<std::function<void()>> tasks_;
+		std::mutex mutex_;
+		std::condition_variable tasks_cv_;
+		bool stopping_ = false;
+
+		void Submit(std::function<void()> task);
+		void WorkerLoop();
+	};
+
+	template <typename Func>
+	void ThreadPool::ParallelFor(size_t count, const Func& func) {
+		if (count == 0) {
+			return;
+		}
+
+		std::atomic<size_t> next_index{ 0 };
+		std::exception_ptr error;
+		std::mutex done_mutex;
+		std::condition_variable done_cv;
+		size_t helpers_left = std::min(workers_.size(), count - 1);
+
+		// Каждый исполнитель забирает очередной индекс, пока они не закончатся
+		auto run = [&]() {
+			for (size_t index = next_index++; index < count; index = next_index++) {
+				try {
+					func(index);
+				}
+				catch (...) {
+					std::lock_guard guard(done_mutex);
+					if (!error) {
+						error = std::current_exception();
+					}
+					next_index = count;
+				}
+			}
+		};
+
+		for (size_t helper = 0, helpers_count = helpers_left; helper < helpers_count; ++helper) {
+			Submit([&]() {
+				run();
+				std::lock_guard guard(done_mutex);
+				if (--helpers_left == 0) {
+					done_cv.notify_one();
+				}
+			});
+		}
+
+		run();
+
+		std::unique_lock lock(done_mutex);
+		done_cv.wait(lock, [&helpers_left]() { return helpers_left == 0; });
+		if (error) {
+			std::rethrow_exception(error);
+		}
+	}
+
+} // namespace concurrency
@@ -5,7 +5,7 @@ namespace Catalogue {
 	using namespace domain;
 	
 	void TransportCatalogue::AddStop(std::string_view stop_name, double latitude, double longitude) {
-		stops_.push_back({ std::string(stop_name), {latitude, longitude} });
+		stops_.push_back({ InternName(stop_name), {latitude, longitude}, stops_.size() });
 		stopname_to_stop_.insert({ stops_.back().stop_name_, &stops_.back() });
 
 		stop_to_buses_[&stops_.back()];
@@ -79,12 +79,13 @@ namespace Catalogue {
 		std::unordered_set<const Stop*> unique_stops(temp_stops.begin(), temp_stops.end());
 
 		// Добавляем новый мрашрут
-		buses_.push_back({ std::string(bus_name),
+		buses_.push_back({ InternName(bus_name),
 			temp_stops,
 			is_circular,
 			unique_stops.size(),
 			real_distance,
-			geo_distance
+			geo_distance,
+			buses_.size()
 		});
 		busname_to_bus_.insert({ buses_.back().bus_name_, &buses_.back() });		
 		buses_names_.insert(buses_.back().bus_name_);
@@ -140,6 +141,22 @@ namespace Catalogue {
 		return stopname_to_stop_;
 	}
 
+	size_t TransportCatalogue::GetStopCount() const {
+		return stops_.size();
+	}
+
+	const Stop& TransportCatalogue::GetStop(size_t id) const {
+		return stops_.at(id);
+	}
+
+	size_t TransportCatalogue::GetBusCount() const {
+		return buses_.size();
+	}
+
+	const Bus& TransportCatalogue::GetBus(size_t id) const {
+		return buses_.at(id);
+	}
+
 	std::optional<double> TransportCatalogue::GetDistance(const Stop* stop1, const Stop* stop2) const {
 		if (stops_to_distance_.find({ stop1, stop2 }) != stops_to_distance_.end()) {
 			return stops_to_distance_.at({ stop1, stop2 });
@@ -158,6 +175,20 @@ namespace Catalogue {
 		}
 	}
 
+	size_t TransportCatalogue::GetNameMemoryUsage() const {
+		return names_.GetMemoryUsage();
+	}
+
+	std::string_view TransportCatalogue::InternName(std::string_view name) {
+		if (const auto stop = stopname_to_stop_.find(name); stop != stopname_to_stop_.end()) {
+			return stop->first;
+		}
+		if (const auto bus = busname_to_bus_.find(name); bus != busname_to_bus_.end()) {
+			return bus->first;
+		}
+		return names_.Add(name);
+	}
+
 	size_t TransportCatalogue::StopsToDistanceHasher::operator()(const std::pair<const Stop*, const Stop*>& data) const
 	{		
 		return stop_ptr_hasher_(data.first) + (37 ^ 2) * stop_ptr_hasher_(data.second);		
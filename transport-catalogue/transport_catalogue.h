@@ -10,6 +10,7 @@
 #include <set>
 
 #include "domain.h"
+#include "name_arena.h"
 
 namespace Catalogue {	
 
@@ -45,8 +46,17 @@ namespace Catalogue {
 		const std::set<std::string_view>& GetBuses() const;
 		const std::unordered_map<std::string_view, const domain::Stop*>& GetAllStops() const;
 
+		// - /  /    id_
+		size_t GetStopCount() const;
+		const domain::Stop& GetStop(size_t id) const;
+		size_t GetBusCount() const;
+		const domain::Bus& GetBus(size_t id) const;
+
 		//      stop1  stop2,        stop2  stop 1
 		double GetStopToStopDistance(const domain::Stop* stop1, const domain::Stop* stop2) const;
+
+		//         
+		size_t GetNameMemoryUsage() const;
 	private:
 		struct StopsToDistanceHasher {
 			std::hash<const void*> stop_ptr_hasher_;
@@ -54,6 +64,8 @@ namespace Catalogue {
 			size_t operator() (const std::pair<const domain::Stop*, const domain::Stop*>& data) const;
 		};
 
+		//    ,      
+		NameArena names_;
 		std::deque<domain::Stop> stops_;
 		std::deque<domain::Bus> buses_;
 		//    
@@ -71,6 +83,9 @@ namespace Catalogue {
 
 		//      stop1  stop2,      nullopt
 		std::optional<double> GetDistance(const domain::Stop* stop1, const domain::Stop* stop2) const;
+		//       ,  name,     -  name
+		//  .          
+		std::string_view InternName(std::string_view name);
 	};
 
 }
\ No newline at end of file
@@ -1,92 +1,776 @@
 #include "transport_router.h"
 
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <type_traits>
+
 namespace router {
 
+	namespace {
+		constexpr double CENTISECONDS_PER_MINUTE = 6000.0;
+	}
+
+	Weight ToWeight(double minutes, bool round_down) {
+		if constexpr (std::is_integral_v<Weight>) {
+			const double centiseconds = minutes * CENTISECONDS_PER_MINUTE;
+			//       
+			constexpr Weight MAX_WEIGHT = std::numeric_limits<Weight>::max();
+			if (centiseconds >= static_cast<double>(MAX_WEIGHT)) {
+				return MAX_WEIGHT;
+			}
+			return static_cast<Weight>(round_down ? std::floor(centiseconds) : std::round(centiseconds));
+		}
+		else {
+			return static_cast<Weight>(minutes);
+		}
+	}
+
+	double ToMinutes(Weight weight) {
+		if constexpr (std::is_integral_v<Weight>) {
+			return weight / CENTISECONDS_PER_MINUTE;
+		}
+		else {
+			return weight;
+		}
+	}
+
 	TransportRouter::TransportRouter(const Catalogue::TransportCatalogue& catalogue, const TransportRouterSettings& settings)
-		: catalogue_(catalogue), settings_(settings), graph_(std::move(CreateGraph())), transport_router_(graph_) {				
+		: catalogue_(catalogue), settings_(settings)
+		, route_cache_(settings.route_cache_capacity_) {
+		if (IsGraphRequired()) {
+			graph_ = CreateGraph();
+			if (settings_.vertex_order_ != VertexOrder::CREATION) {
+				ReorderVertexes();
+			}
+		}
+		else {
+			//   ,        ,  
+			NumerateStops(settings_.graph_model_ == GraphModel::LINEAR ? 1 : 2);
+		}
+		InitializeRouter();
 	}
 
 	TransportRouter::TransportRouter(
 		const Catalogue::TransportCatalogue& catalogue,
 		const TransportRouterSettings& settings,
-		graph::DirectedWeightedGraph<double>&& graph
-	): catalogue_(catalogue), settings_(settings), graph_(std::move(graph)), transport_router_(graph_) {
-		//          ,  
-		const auto& stops = catalogue_.GetAllStops();
+		graph::DirectedWeightedGraph<Weight>&& graph,
+		PrecomputedRouterData&& precomputed
+	): catalogue_(catalogue), settings_(settings), graph_(std::move(graph))
+		, route_cache_(settings.route_cache_capacity_) {
+		//     .     ,       
+		if (precomputed.stop_vertexes.empty()) {
+			NumerateStops(settings_.graph_model_ == GraphModel::LINEAR ? 1 : 2);
+		}
+		else {
+			if (precomputed.stop_vertexes.size() != catalogue_.GetStopCount()) {
+				throw std::invalid_argument("Stop vertexes don't match the catalogue");
+			}
+			stop_vertexes_ = std::move(precomputed.stop_vertexes);
+			IndexStopVertexes(graph_.GetVertexCount());
+		}
+
+		//    ,    :     .
+		//  ,          make_base,
+		//          
+		if (precomputed.bus_wait_time != settings_.bus_wait_time_ || precomputed.bus_velocity != settings_.bus_velocity_) {
+			precomputed.routes_table.reset();
+			precomputed.contraction_hierarchy.reset();
+			precomputed.hub_labels.reset();
+		}
+		CustomizeWeights();
+
+		InitializeRouter(std::move(precomputed));
+	}
+
+	void TransportRouter::NumerateStops(size_t step) {
+		const size_t stop_count = catalogue_.GetStopCount();
+		stop_vertexes_.resize(stop_count);
+		for (size_t stop_id = 0; stop_id < stop_count; ++stop_id) {
+			stop_vertexes_[stop_id] = stop_id * step;
+		}
+		IndexStopVertexes(stop_count * step);
+	}
+
+	void TransportRouter::ReorderVertexes() {
+		//        :    -  stop_vertexes_,
+		//   -   .        
+		const std::vector<graph::VertexId> new_ids = graph::ComputeReverseCuthillMcKeeOrder(graph_);
+		graph_.PermuteVertexes(new_ids);
+		for (graph::VertexId& vertex : stop_vertexes_) {
+			vertex = new_ids[vertex];
+		}
+		IndexStopVertexes(graph_.GetVertexCount());
+	}
+
+	void TransportRouter::IndexStopVertexes(size_t vertex_count) {
+		vertex_stops_.assign(vertex_count, nullptr);
+		for (size_t stop_id = 0; stop_id < stop_vertexes_.size(); ++stop_id) {
+			vertex_stops_.at(stop_vertexes_[stop_id]) = &catalogue_.GetStop(stop_id);
+		}
+	}
+
+	std::optional<graph::VertexId> TransportRouter::FindStopVertex(std::string_view stop_name) const {
+		const domain::Stop* stop = catalogue_.FindStop(stop_name);
+		if (!stop) {
+			return std::nullopt;
+		}
+		return stop_vertexes_[stop->id_];
+	}
+
+	const domain::Stop* TransportRouter::GetVertexStop(graph::VertexId vertex) const {
+		return vertex < vertex_stops_.size() ? vertex_stops_[vertex] : nullptr;
+	}
+
+	double TransportRouter::ComputeRideTime(double distance) const {
+		//   /   /
+		return distance / (settings_.bus_velocity_ / 0.06);
+	}
+
+	Weight TransportRouter::ComputeEdgeWeight(const graph::EdgeInfo& edge_info) const {
+		//    -  ,  -  ( -   )
+		return edge_info.HasBus() ? ToWeight(ComputeRideTime(edge_info.distance)) : ToWeight(settings_.bus_wait_time_);
+	}
+
+	void TransportRouter::CustomizeWeights() {
+		graph_.Reweight([this](graph::EdgeId, const graph::EdgeInfo& edge_info) {
+			return ComputeEdgeWeight(edge_info);
+		});
+	}
+
+	bool TransportRouter::IsGraphRequired() const {
+		return settings_.router_type_ != RouterType::RAPTOR || settings_.hub_labels_;
+	}
+
+	void TransportRouter::InitializeGraphSearch(std::optional<graph::Connectivity::ComponentsData>&& components) {
+		//    ,    CSR   
+		graph_.Freeze();
+
+		pareto_router_.emplace(graph_, [this](graph::EdgeId edge_id) {
+			return !graph_.GetEdgeInfo(edge_id).HasBus();
+		});
+
+		if (components) {
+			connectivity_.emplace(std::move(*components));
+			if (connectivity_->GetVertexCount() != graph_.GetVertexCount()) {
+				throw std::invalid_argument("Graph components don't match the graph");
+			}
+		}
+		else {
+			connectivity_.emplace(graph_);
+		}
+	}
+
+	void TransportRouter::EnsureGraph() {
+		if (connectivity_) {
+			return;
+		}
+		//      :     ,
+		//      
+		if (!graph_.IsFrozen()) {
+			graph_ = CreateGraph();
+			settings_.vertex_order_ = VertexOrder::CREATION;
+		}
+		InitializeGraphSearch();
+	}
 
-		size_t initial_id = 0;
-		for (const auto& stop : stops) {
-			stop_to_id_[stop.first] = initial_id;
-			id_to_stop_[initial_id] = stop.first;
+	const graph::DijkstraRouter<Weight>& TransportRouter::GetDijkstraRouter() {
+		EnsureGraph();
+		if (!dijkstra_router_) {
+			dijkstra_router_.emplace(graph_);
+		}
+		return *dijkstra_router_;
+	}
+
+	void TransportRouter::InitializeRouter(PrecomputedRouterData&& precomputed) {
+		if (IsGraphRequired()) {
+			InitializeGraphSearch(std::move(precomputed.components));
+		}
+
+		switch (settings_.router_type_) {
+		case RouterType::ALL_PAIRS:
+			if (precomputed.routes_table) {
+				all_pairs_router_.emplace(graph_, std::move(*precomputed.routes_table));
+			}
+			else {
+				//      ,      :
+				//    ,  ,   
+				if (settings_.memory_report_) {
+					const size_t vertex_count = graph_.GetVertexCount();
+					std::cerr << "Routes table: building " << vertex_count * vertex_count
+						* (sizeof(graph::Router<Weight>::TableWeight) + sizeof(uint32_t)) << " bytes for "
+						<< vertex_count << " vertices\n";
+				}
+				all_pairs_router_.emplace(graph_);
+			}
+			break;
+		case RouterType::CONTRACTION_HIERARCHIES:
+			if (precomputed.contraction_hierarchy) {
+				contraction_hierarchy_.emplace(graph_, std::move(*precomputed.contraction_hierarchy));
+			}
+			else {
+				contraction_hierarchy_.emplace(graph_);
+			}
+			break;
+		case RouterType::A_STAR:
+			InitializeAStarPotential();
+			dijkstra_router_.emplace(graph_);
+			break;
+		case RouterType::DIJKSTRA:
+			dijkstra_router_.emplace(graph_);
+			break;
+		case RouterType::RAPTOR:
+			raptor_router_.emplace(catalogue_, ToWeight(settings_.bus_wait_time_), [this](double distance) {
+				return ToWeight(ComputeRideTime(distance));
+			});
+			break;
+		}
 
-			initial_id += 2;
+		if (settings_.hub_labels_) {
+			if (precomputed.hub_labels) {
+				hub_labels_.emplace(std::move(*precomputed.hub_labels));
+				if (hub_labels_->GetVertexCount() != graph_.GetVertexCount()) {
+					throw std::invalid_argument("Hub labels don't match the graph");
+				}
+			}
+			else if (contraction_hierarchy_) {
+				hub_labels_.emplace(*contraction_hierarchy_);
+			}
+			else {
+				//          
+				const graph::ContractionHierarchy<Weight> hierarchy(graph_);
+				hub_labels_.emplace(hierarchy);
+			}
 		}
 	}
 
-	const graph::DirectedWeightedGraph<double> TransportRouter::GetGraph() const {
-		return graph_;
+	void TransportRouter::InitializeAStarPotential() {
+		const size_t stop_count = stop_vertexes_.size();
+		vertex_stop_indexes_.assign(graph_.GetVertexCount(), 0);
+		stop_coordinates_.resize(stop_count);
+		for (size_t stop_index = 0; stop_index < stop_count; ++stop_index) {
+			vertex_stop_indexes_[stop_vertexes_[stop_index]] = stop_index;
+			stop_coordinates_[stop_index] = catalogue_.GetStop(stop_index).stop_coordinates_;
+		}
+
+		//     ,         :
+		//    (  COMPLETE -  2n + 1,  LINEAR -  " ")
+		//       LINEAR.      
+		for (graph::EdgeId edge_id = 0; edge_id < graph_.GetEdgeCount(); ++edge_id) {
+			const auto& edge = graph_.GetEdge(edge_id);
+			const graph::EdgeInfo& edge_info = graph_.GetEdgeInfo(edge_id);
+			if (!edge_info.HasBus()) {
+				vertex_stop_indexes_[edge.to] = vertex_stop_indexes_[edge.from];
+			}
+			else if (edge_info.span_count == 0) {
+				vertex_stop_indexes_[edge.from] = vertex_stop_indexes_[edge.to];
+			}
+		}
+
+		//        ,   
+		//        .   
+		//      ,     
+		double min_curvature = std::numeric_limits<double>::infinity();
+		auto update_curvature = [this, &min_curvature](const domain::Stop* from, const domain::Stop* to) {
+			const double geo_distance = geo::ComputeDistance(from->stop_coordinates_, to->stop_coordinates_);
+			if (geo_distance > 0) {
+				min_curvature = std::min(min_curvature, catalogue_.GetStopToStopDistance(from, to) / geo_distance);
+			}
+		};
+		for (const auto& bus_name : catalogue_.GetBuses()) {
+			const domain::Bus* bus = catalogue_.FindBus(bus_name);
+			for (size_t i = 1; i < bus->stops_.size(); ++i) {
+				update_curvature(bus->stops_[i - 1], bus->stops_[i]);
+				if (!bus->is_circular_) {
+					update_curvature(bus->stops_[i], bus->stops_[i - 1]);
+				}
+			}
+			if (bus->is_circular_ && bus->stops_.size() > 1) {
+				update_curvature(bus->stops_.back(), bus->stops_.front());
+			}
+		}
+		if (min_curvature == std::numeric_limits<double>::infinity()) {
+			min_curvature = 0;
+		}
+		//      
+		min_time_per_meter_ = ComputeRideTime(min_curvature * A_STAR_POTENTIAL_MARGIN);
+	}
+
+	std::optional<graph::DijkstraRouter<Weight>::RouteInfo> TransportRouter::BuildAStarRoute(graph::VertexId from,
+		graph::VertexId to) const {
+		//     ,    : DijkstraRouter     
+		const geo::Coordinates& target = stop_coordinates_[vertex_stop_indexes_[to]];
+		return dijkstra_router_->BuildRoute(from, to, [this, &target](graph::VertexId vertex) {
+			//         
+			return ToWeight(geo::ComputeDistance(stop_coordinates_[vertex_stop_indexes_[vertex]], target) * min_time_per_meter_,
+				true);
+		});
+	}
+
+	const graph::DirectedWeightedGraph<Weight>* TransportRouter::GetGraph() const {
+		return connectivity_ ? &graph_ : nullptr;
+	}
+
+	const graph::Router<Weight>* TransportRouter::GetAllPairsRouter() const {
+		return all_pairs_router_ ? &*all_pairs_router_ : nullptr;
+	}
+
+	const graph::ContractionHierarchy<Weight>* TransportRouter::GetContractionHierarchy() const {
+		return contraction_hierarchy_ ? &*contraction_hierarchy_ : nullptr;
+	}
+
+	const RaptorRouter<Weight>* TransportRouter::GetRaptorRouter() const {
+		return raptor_router_ ? &*raptor_router_ : nullptr;
+	}
+
+	const graph::HubLabels<Weight>* TransportRouter::GetHubLabels() const {
+		return hub_labels_ ? &*hub_labels_ : nullptr;
+	}
+
+	const std::vector<graph::VertexId>& TransportRouter::GetStopVertexes() const {
+		return stop_vertexes_;
+	}
+
+	const graph::Connectivity* TransportRouter::GetConnectivity() const {
+		return connectivity_ ? &*connectivity_ : nullptr;
+	}
+
+	void TransportRouter::PrintMemoryReport(std::ostream& output) const {
+		const size_t vertex_count = graph_.GetVertexCount();
+		const size_t edge_count = graph_.GetEdgeCount();
+
+		const size_t graph_bytes = graph_.GetMemoryUsage();
+
+		output << "Router memory report:\n";
+		if (!connectivity_) {
+			output << "  graph: not built\n";
+		}
+		else {
+			output << "  vertices: " << vertex_count << ", edges: " << edge_count << "\n"
+				<< "  graph: " << graph_bytes << " bytes\n"
+				<< "  vertex order: " << (settings_.vertex_order_ == VertexOrder::REVERSE_CUTHILL_MCKEE ? "rcm" : "creation")
+				<< ", mean edge vertex gap: " << graph::ComputeMeanEdgeVertexGap(graph_) << "\n"
+				<< "  components: " << connectivity_->GetStrongComponentCount() << " strong, "
+				<< connectivity_->GetWeakComponentCount() << " weak, " << connectivity_->GetMemoryUsage() << " bytes\n";
+		}
+
+		if (all_pairs_router_) {
+			//   : vector<vector<optional<{double, optional<EdgeId>}>>>
+			struct LegacyRouteInternalData {
+				double weight;
+				std::optional<graph::EdgeId> prev_edge;
+			};
+			const size_t legacy_bytes = vertex_count * (sizeof(std::vector<int>)
+				+ vertex_count * sizeof(std::optional<LegacyRouteInternalData>));
+			const size_t table_bytes = all_pairs_router_->GetRoutesTableMemoryUsage();
+
+			output << "  routes table: " << table_bytes << " bytes ("
+				<< sizeof(graph::Router<Weight>::TableWeight) + sizeof(uint32_t) << " bytes per vertex pair, "
+				<< (std::is_same_v<graph::Router<Weight>::TableWeight, float> ? graph::GetRelaxRowKernelName() : "scalar")
+				<< " relaxation kernel)\n"
+				<< "  routes table in the previous layout: " << legacy_bytes << " bytes ("
+				<< sizeof(std::optional<LegacyRouteInternalData>) << " bytes per vertex pair)\n";
+		}
+
+		if (contraction_hierarchy_) {
+			const auto& hierarchy = contraction_hierarchy_->GetHierarchyData();
+			const size_t hierarchy_bytes = hierarchy.ranks.capacity() * sizeof(uint32_t)
+				+ hierarchy.shortcuts.capacity() * sizeof(graph::ContractionHierarchy<Weight>::Shortcut);
+
+			output << "  contraction hierarchy: " << hierarchy.shortcuts.size() << " shortcuts, "
+				<< hierarchy_bytes << " bytes\n";
+		}
+
+		if (raptor_router_) {
+			output << "  raptor: " << raptor_router_->GetTripCount() << " trips, "
+				<< raptor_router_->GetMemoryUsage() << " bytes\n";
+		}
+
+		if (hub_labels_) {
+			output << "  hub labels: " << hub_labels_->GetLabelEntryCount() << " entries ("
+				<< static_cast<double>(hub_labels_->GetLabelEntryCount()) / (2 * std::max<size_t>(vertex_count, 1))
+				<< " per label), " << hub_labels_->GetMemoryUsage() << " bytes\n";
+		}
 	}
 
 	std::optional<RouteData> TransportRouter::BuildTransportRoute(std::string_view from, std::string_view to) {
-		RouteData route_result;
+		const auto from_vertex = FindStopVertex(from);
+		const auto to_vertex = FindStopVertex(to);
+		if (!from_vertex || !to_vertex) {
+			return std::nullopt;
+		}
+		const graph::VertexId from_id = *from_vertex;
+		const graph::VertexId to_id = *to_vertex;
+		//     :  ,    
+		if (connectivity_ && !connectivity_->MayReach(from_id, to_id)) {
+			return std::nullopt;
+		}
+		if (!route_cache_.IsEnabled()) {
+			return ComputeTransportRoute(from_id, to_id);
+		}
+
+		const uint64_t cache_key = (static_cast<uint64_t>(from_id) << 32) | static_cast<uint64_t>(to_id);
+		if (auto cached = route_cache_.Get(cache_key)) {
+			return std::move(*cached);
+		}
+		auto route_result = ComputeTransportRoute(from_id, to_id);
+		route_cache_.Put(cache_key, route_result);
+		return route_result;
+	}
+
+	std::optional<double> TransportRouter::ComputeTravelTime(std::string_view from, std::string_view to) {
+		if (!hub_labels_) {
+			const auto route = BuildTransportRoute(from, to);
+			return route ? std::optional<double>(route->total_time_) : std::nullopt;
+		}
+		const auto from_vertex = FindStopVertex(from);
+		const auto to_vertex = FindStopVertex(to);
+		if (!from_vertex || !to_vertex || !connectivity_->MayReach(*from_vertex, *to_vertex)) {
+			return std::nullopt;
+		}
+		const auto weight = hub_labels_->ComputeWeight(*from_vertex, *to_vertex);
+		return weight ? std::optional<double>(ToMinutes(*weight)) : std::nullopt;
+	}
+
+	cache::CacheStats TransportRouter::GetRouteCacheStats() const {
+		return route_cache_.GetStats();
+	}
+
+	std::optional<RouteData> TransportRouter::ComputeTransportRoute(graph::VertexId from_id, graph::VertexId to_id) {
+		// RAPTOR   ,     
+		if (raptor_router_) {
+			const auto route = raptor_router_->BuildRoute(GetVertexStop(from_id)->id_, GetVertexStop(to_id)->id_);
+			if (!route.has_value()) {
+				return std::nullopt;
+			}
+			return MakeRouteData(*route);
+		}
 		//  
-		const auto route = transport_router_.BuildRoute(
-			stop_to_id_[from],
-			stop_to_id_[to]
-		);
+		const auto route = all_pairs_router_ ? all_pairs_router_->BuildRoute(from_id, to_id)
+			: contraction_hierarchy_ ? contraction_hierarchy_->BuildRoute(from_id, to_id)
+			: settings_.router_type_ == RouterType::A_STAR ? BuildAStarRoute(from_id, to_id)
+			: dijkstra_router_->BuildRoute(from_id, to_id);
 		//      ,  Nullopt
 		if (!route.has_value()) {
 			return std::nullopt;
 		}
-		else {
-			route_result.total_time_ = route.value().weight;
-			//       
-			for (const auto& edge_id : route.value().edges) {
-				const graph::Edge<double>& edge = graph_.GetEdge(edge_id);
-				//  Nullopt -    
-				if (edge.info == std::nullopt) {
-					route_result.route_points.emplace_back(RouteWaitInfo{
-						id_to_stop_[edge.from],
-						edge.weight
-					});
+		return MakeRouteData(route.value().weight, route.value().edges);
+	}
+
+	RouteData TransportRouter::MakeRouteData(Weight weight, const std::vector<graph::EdgeId>& edges) const {
+		RouteData route_result;
+		route_result.total_time_ = ToMinutes(weight);
+		//     :   LINEAR    
+		//       
+		bool on_board = false;
+		//       
+		for (const auto& edge_id : edges) {
+			const graph::Edge<Weight>& edge = graph_.GetEdge(edge_id);
+			const graph::EdgeInfo& edge_info = graph_.GetEdgeInfo(edge_id);
+			//    -    
+			if (!edge_info.HasBus()) {
+				route_result.route_points.emplace_back(RouteWaitInfo{
+					GetVertexStop(edge.from)->stop_name_,
+					ToMinutes(edge.weight)
+				});
+				on_board = false;
+			}
+			//     ( LINEAR),    
+			else if (edge_info.span_count == 0) {
+				on_board = false;
+			}
+			//      
+			else if (on_board) {
+				RouteBusInfo& bus_info = std::get<RouteBusInfo>(route_result.route_points.back());
+				bus_info.span_count += edge_info.span_count;
+				bus_info.time += ToMinutes(edge.weight);
+			}
+			//      
+			else {
+				route_result.route_points.emplace_back(RouteBusInfo{
+					catalogue_.GetBus(edge_info.bus_id).bus_name_,
+					static_cast<int>(edge_info.span_count),
+					ToMinutes(edge.weight)
+				});
+				on_board = true;
+			}
+		}
+
+		return route_result;
+	}
+
+	RouteData TransportRouter::MakeRouteData(const RaptorRouter<Weight>::RouteInfo& route) const {
+		RouteData route_result;
+		route_result.total_time_ = ToMinutes(route.weight);
+		//   -         
+		for (const auto& leg : route.legs) {
+			route_result.route_points.emplace_back(RouteWaitInfo{
+				leg.board_stop->stop_name_,
+				ToMinutes(ToWeight(settings_.bus_wait_time_))
+			});
+			route_result.route_points.emplace_back(RouteBusInfo{
+				catalogue_.GetBus(leg.bus_id).bus_name_,
+				static_cast<int>(leg.span_count),
+				ToMinutes(leg.ride_weight)
+			});
+		}
+		return route_result;
+	}
+
+	std::vector<ParetoRouteData> TransportRouter::BuildParetoRoutes(std::string_view from, std::string_view to,
+		std::optional<double> max_extra_time) {
+		EnsureGraph();
+		const auto from_vertex = FindStopVertex(from);
+		const auto to_vertex = FindStopVertex(to);
+		if (!from_vertex || !to_vertex || !connectivity_->MayReach(*from_vertex, *to_vertex)) {
+			return {};
+		}
+
+		const Weight max_extra_weight = max_extra_time
+			? ToWeight(std::max(*max_extra_time, 0.0))
+			: graph::ParetoRouter<Weight>::INFINITE_WEIGHT;
+		std::vector<ParetoRouteData> result;
+		for (const auto& route : pareto_router_->BuildRoutes(*from_vertex, *to_vertex, max_extra_weight)) {
+			//     ,    ,  
+			result.push_back({
+				MakeRouteData(route.weight, route.edges),
+				std::max(static_cast<int>(route.counted_edges) - 1, 0)
+			});
+		}
+		return result;
+	}
+
+	std::vector<RouteData> TransportRouter::BuildAlternativeRoutes(std::string_view from, std::string_view to,
+		size_t count) {
+		EnsureGraph();
+		const auto from_vertex = FindStopVertex(from);
+		const auto to_vertex = FindStopVertex(to);
+		if (!from_vertex || !to_vertex || !connectivity_->MayReach(*from_vertex, *to_vertex)) {
+			return {};
+		}
+
+		//           
+		const graph::DijkstraRouter<Weight>& search_router = GetDijkstraRouter();
+
+		//        : ,    
+		//    - .   -       
+		auto is_same_route = [this](const std::vector<graph::EdgeId>& lhs, const std::vector<graph::EdgeId>& rhs) {
+			return std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end(), [this](graph::EdgeId lhs_id, graph::EdgeId rhs_id) {
+				const graph::EdgeInfo& lhs_info = graph_.GetEdgeInfo(lhs_id);
+				const graph::EdgeInfo& rhs_info = graph_.GetEdgeInfo(rhs_id);
+				return lhs_info.HasBus() == rhs_info.HasBus()
+					&& (!lhs_info.HasBus() || (lhs_info.bus_id == rhs_info.bus_id && lhs_info.span_count == rhs_info.span_count))
+					&& GetVertexStop(graph_.GetEdge(lhs_id).from) == GetVertexStop(graph_.GetEdge(rhs_id).from)
+					&& graph_.GetEdge(lhs_id).weight == graph_.GetEdge(rhs_id).weight;
+			});
+		};
+
+		//         ,     , -  ,
+		//       .   COMPLETE           
+		auto is_allowed_route = [this](const std::vector<graph::EdgeId>& edges) {
+			return !HasNeedlessReboarding(edges);
+		};
+
+		std::vector<RouteData> result;
+		for (const auto& route : search_router.BuildRoutes(*from_vertex, *to_vertex, count, is_same_route,
+			is_allowed_route)) {
+			result.push_back(MakeRouteData(route.weight, route.edges));
+		}
+		return result;
+	}
+
+	bool TransportRouter::HasDirectRide(graph::VertexId from, graph::VertexId to, uint32_t bus_id,
+		uint32_t max_distance) const {
+		//      bus_id      from:   COMPLETE  
+		//  ,  LINEAR -      . и   
+		std::vector<std::pair<graph::VertexId, uint32_t>> stack;
+		for (const graph::EdgeId wait_edge_id : graph_.GetIncidentEdges(from)) {
+			if (!graph_.GetEdgeInfo(wait_edge_id).HasBus()) {
+				stack.emplace_back(graph_.GetEdge(wait_edge_id).to, 0);
+			}
+		}
+		while (!stack.empty()) {
+			const auto [vertex, distance] = stack.back();
+			stack.pop_back();
+			if (vertex == to) {
+				return true;
+			}
+			for (const graph::EdgeId edge_id : graph_.GetIncidentEdges(vertex)) {
+				const graph::EdgeInfo& edge_info = graph_.GetEdgeInfo(edge_id);
+				if (edge_info.bus_id == bus_id && edge_info.distance <= max_distance - distance) {
+					stack.emplace_back(graph_.GetEdge(edge_id).to, distance + edge_info.distance);
 				}
-				//      
-				else {
-					route_result.route_points.emplace_back(RouteBusInfo{
-						edge.info.value().first,
-						edge.info.value().second,
-						edge.weight
-					});
+			}
+		}
+		return false;
+	}
+
+	bool TransportRouter::HasNeedlessReboarding(const std::vector<graph::EdgeId>& edges) const {
+		//  -     .     , 
+		//     -    
+		struct Ride {
+			uint32_t bus_id = graph::EdgeInfo::NO_BUS;
+			uint32_t distance = 0;
+			graph::VertexId from = 0;
+		};
+		Ride previous_ride;
+		Ride ride;
+		graph::VertexId wait_from = 0;
+		for (size_t index = 0; index < edges.size(); ++index) {
+			const graph::EdgeInfo& edge_info = graph_.GetEdgeInfo(edges[index]);
+			if (!edge_info.HasBus()) {
+				wait_from = graph_.GetEdge(edges[index]).from;
+				continue;
+			}
+			if (index == 0 || !graph_.GetEdgeInfo(edges[index - 1]).HasBus()) {
+				previous_ride = ride;
+				ride = { edge_info.bus_id, 0, wait_from };
+			}
+			ride.distance += edge_info.distance;
+
+			//       :    ,   .
+			//    (  ,   )    ( 
+			//   ),       
+			const bool is_ride_end = index + 1 == edges.size() || !graph_.GetEdgeInfo(edges[index + 1]).HasBus();
+			if (is_ride_end && previous_ride.bus_id == ride.bus_id
+				&& HasDirectRide(previous_ride.from, graph_.GetEdge(edges[index]).to, ride.bus_id,
+					previous_ride.distance + ride.distance)) {
+				return true;
+			}
+		}
+		return false;
+	}
+
+	TravelTimeMatrix TransportRouter::ComputeTravelTimeMatrix(
+		const std::vector<std::string_view>& from_stops,
+		const std::vector<std::string_view>& to_stops
+	) {
+		std::vector<graph::VertexId> targets;
+		std::vector<bool> target_found;
+		for (const std::string_view stop_name : to_stops) {
+			const auto vertex = FindStopVertex(stop_name);
+			targets.push_back(vertex.value_or(0));
+			target_found.push_back(vertex.has_value());
+		}
+
+		//       ,          
+		const graph::DijkstraRouter<Weight>* search_router = nullptr;
+		if (!all_pairs_router_ && !hub_labels_ && !raptor_router_) {
+			search_router = &GetDijkstraRouter();
+		}
+
+		TravelTimeMatrix result;
+		result.reserve(from_stops.size());
+		for (const std::string_view stop_name : from_stops) {
+			std::vector<std::optional<double>>& row = result.emplace_back(to_stops.size());
+			const auto from = FindStopVertex(stop_name);
+			if (!from) {
+				continue;
+			}
+
+			if (hub_labels_ && !all_pairs_router_) {
+				//           
+				for (size_t i = 0; i < targets.size(); ++i) {
+					if (target_found[i]) {
+						if (const auto weight = hub_labels_->ComputeWeight(*from, targets[i])) {
+							row[i] = ToMinutes(*weight);
+						}
+					}
 				}
 			}
-		}		
+			else if (all_pairs_router_) {
+				//        
+				for (size_t i = 0; i < targets.size(); ++i) {
+					if (target_found[i]) {
+						if (const auto weight = all_pairs_router_->GetWeight(*from, targets[i])) {
+							row[i] = ToMinutes(*weight);
+						}
+					}
+				}
+			}
+			else if (raptor_router_) {
+				//   RAPTOR       
+				const auto weights = raptor_router_->ComputeWeights(GetVertexStop(*from)->id_);
+				for (size_t i = 0; i < targets.size(); ++i) {
+					if (target_found[i]) {
+						const Weight weight = weights[GetVertexStop(targets[i])->id_];
+						if (weight != RaptorRouter<Weight>::INFINITE_WEIGHT) {
+							row[i] = ToMinutes(weight);
+						}
+					}
+				}
+			}
+			else {
+				//      :       
+				std::vector<graph::VertexId> row_targets;
+				std::vector<size_t> row_indexes;
+				for (size_t i = 0; i < targets.size(); ++i) {
+					if (target_found[i] && connectivity_->MayReach(*from, targets[i])) {
+						row_targets.push_back(targets[i]);
+						row_indexes.push_back(i);
+					}
+				}
+				if (row_targets.empty()) {
+					continue;
+				}
+				const auto weights = search_router->ComputeWeights(*from, row_targets);
+				for (size_t i = 0; i < row_targets.size(); ++i) {
+					if (weights[i]) {
+						row[row_indexes[i]] = ToMinutes(*weights[i]);
+					}
+				}
+			}
+		}
 
-		return route_result;
+		return result;
+	}
+
+	std::optional<std::vector<ReachableStopInfo>> TransportRouter::ComputeReachableStops(std::string_view from,
+		double max_time) {
+		const auto from_vertex = FindStopVertex(from);
+		if (!from_vertex) {
+			return std::nullopt;
+		}
+		//         from.  , ToWeight
+		//        
+		if (!(max_time >= 0)) {
+			return std::vector<ReachableStopInfo>{};
+		}
+		const graph::DijkstraRouter<Weight>& search_router = GetDijkstraRouter();
+
+		//          
+		std::vector<ReachableStopInfo> result;
+		for (const auto& [vertex, weight] : search_router.ComputeReachable(*from_vertex, ToWeight(max_time, true))) {
+			if (const domain::Stop* stop = GetVertexStop(vertex)) {
+				result.push_back({ stop->stop_name_, ToMinutes(weight) });
+			}
+		}
+
+		return result;
 	}
 
-	graph::DirectedWeightedGraph<double> TransportRouter::CreateGraph() {
-		const auto& stops = catalogue_.GetAllStops();
-		const auto& buses_names = catalogue_.GetBuses();
+	graph::DirectedWeightedGraph<Weight> TransportRouter::CreateGraph() {
+		switch (settings_.graph_model_) {
+		case GraphModel::LINEAR:
+			return CreateLinearGraph();
+		case GraphModel::COMPLETE:
+		default:
+			return CreateCompleteGraph();
+		}
+	}
+
+	graph::DirectedWeightedGraph<Weight> TransportRouter::CreateCompleteGraph() {
 		//      = 2 * - 
-		graph::DirectedWeightedGraph<double> transport_graph(stops.size() * 2);
+		graph::DirectedWeightedGraph<Weight> transport_graph(catalogue_.GetStopCount() * 2);
 		
-		//         id		
-		//      (   )
-		// ..   n    2*n  (2*n + 1),
+		//      (   )
+		// ..     n    2*n  (2*n + 1),
 		//  2*n   ,  (2*n + 1) -  
-		size_t initial_id = 0;
-		for (const auto& stop : stops) {
-			stop_to_id_[stop.first] = initial_id;
-			id_to_stop_[initial_id] = stop.first;
+		NumerateStops(2);
+		for (const graph::VertexId vertex : stop_vertexes_) {
 			//       
-			transport_graph.AddEdge({
-				initial_id,
-				initial_id + 1,
-				static_cast<double>(settings_.bus_wait_time_),
-				std::nullopt
-			});
-
-			initial_id += 2;
+			transport_graph.AddEdge({ vertex, vertex + 1, ComputeEdgeWeight({}) });
 		}
 
 		//          
@@ -94,8 +778,8 @@ namespace router {
 		//        
 		//    -  (N*(N+1))/2 
 		//   N*(N-1)
-		for (const auto& bus_name : buses_names) {
-			const domain::Bus* bus_search = catalogue_.FindBus(bus_name);			
+		for (uint32_t bus_id = 0; bus_id < catalogue_.GetBusCount(); ++bus_id) {
+			const domain::Bus* bus_search = &catalogue_.GetBus(bus_id);
 			//       Stop1->Stop2-> ... ->StopN->Stop1
 			// (  , Stop1 - )
 			//       Stop1->Stop2->Stop3      Stop3->Stop2->Stop1
@@ -110,21 +794,22 @@ namespace router {
 				for (; stop_num_second < bus_search->stops_.size(); ++stop_num_second) {
 					dist += catalogue_.GetStopToStopDistance(bus_search->stops_[stop_num_second - 1], bus_search->stops_[stop_num_second]);
 					
-					transport_graph.AddEdge({ stop_to_id_[bus_search->stops_[stop_num_first]->stop_name_] + 1,
-						stop_to_id_[bus_search->stops_[stop_num_second]->stop_name_],
-						dist / (settings_.bus_velocity_ / 0.06),
-						std::make_pair(std::string_view(bus_search->bus_name_), stop_num_second - stop_num_first)
-					});
+					const graph::EdgeInfo info{ bus_id, static_cast<uint32_t>(stop_num_second - stop_num_first), static_cast<uint32_t>(dist) };
+					transport_graph.AddEdge({ stop_vertexes_[bus_search->stops_[stop_num_first]->id_] + 1,
+						stop_vertexes_[bus_search->stops_[stop_num_second]->id_],
+						ComputeEdgeWeight(info)
+					}, info);
 
 					//            
 					if (!bus_search->is_circular_) {
 						dist_reversed += catalogue_.GetStopToStopDistance(bus_search->stops_[stop_num_second], bus_search->stops_[stop_num_second - 1]);
 
-						transport_graph.AddEdge({ stop_to_id_[bus_search->stops_[stop_num_second]->stop_name_] + 1,
-							stop_to_id_[bus_search->stops_[stop_num_first]->stop_name_],
-							dist_reversed / (settings_.bus_velocity_ / 0.06),
-							std::make_pair(std::string_view(bus_search->bus_name_), stop_num_second - stop_num_first)
-						});
+						const graph::EdgeInfo reversed_info{ bus_id, static_cast<uint32_t>(stop_num_second - stop_num_first),
+							static_cast<uint32_t>(dist_reversed) };
+						transport_graph.AddEdge({ stop_vertexes_[bus_search->stops_[stop_num_second]->id_] + 1,
+							stop_vertexes_[bus_search->stops_[stop_num_first]->id_],
+							ComputeEdgeWeight(reversed_info)
+						}, reversed_info);
 					}
 
 				}
@@ -134,16 +819,70 @@ namespace router {
 					if (stop_num_first != 0) {
 						dist += catalogue_.GetStopToStopDistance(bus_search->stops_[stop_num_second - 1], bus_search->stops_[0]);
 
-						transport_graph.AddEdge({ stop_to_id_[bus_search->stops_[stop_num_first]->stop_name_] + 1,
-							stop_to_id_[bus_search->stops_[0]->stop_name_],
-							dist / (settings_.bus_velocity_ / 0.06),
-							std::make_pair(std::string_view(bus_search->bus_name_), stop_num_second - stop_num_first)
-						});
+						const graph::EdgeInfo info{ bus_id, static_cast<uint32_t>(stop_num_second - stop_num_first), static_cast<uint32_t>(dist) };
+						transport_graph.AddEdge({ stop_vertexes_[bus_search->stops_[stop_num_first]->id_] + 1,
+							stop_vertexes_[bus_search->stops_[0]->id_],
+							ComputeEdgeWeight(info)
+						}, info);
 					}
 				}
 			}
 		}
 
 		return transport_graph;
-	}	
+	}
+
+	graph::DirectedWeightedGraph<Weight> TransportRouter::CreateLinearGraph() {
+		const size_t stop_count = catalogue_.GetStopCount();
+
+		//  ,     :
+		//    Stop1->Stop2-> ... ->StopN->Stop1,
+		//     Stop1->...->StopN  StopN->...->Stop1
+		std::vector<std::pair<uint32_t, std::vector<const domain::Stop*>>> trips;
+		size_t on_board_vertex_count = 0;
+		for (uint32_t bus_id = 0; bus_id < catalogue_.GetBusCount(); ++bus_id) {
+			const domain::Bus* bus = &catalogue_.GetBus(bus_id);
+			if (bus->stops_.size() < 2) {
+				continue;
+			}
+			if (bus->is_circular_) {
+				std::vector<const domain::Stop*> trip(bus->stops_.begin(), bus->stops_.end());
+				trip.push_back(bus->stops_.front());
+				trips.emplace_back(bus_id, std::move(trip));
+			}
+			else {
+				trips.emplace_back(bus_id, bus->stops_);
+				trips.emplace_back(bus_id, std::vector<const domain::Stop*>(bus->stops_.rbegin(), bus->stops_.rend()));
+			}
+		}
+		for (const auto& trip : trips) {
+			on_board_vertex_count += trip.second.size();
+		}
+
+		//  0 ... N-1 - ,    " "     
+		graph::DirectedWeightedGraph<Weight> transport_graph(stop_count + on_board_vertex_count);
+		NumerateStops(1);
+
+		graph::VertexId on_board_id = stop_count;
+		for (const auto& [bus_id, trip] : trips) {
+			for (size_t position = 0; position < trip.size(); ++position) {
+				const graph::VertexId stop_id = stop_vertexes_[trip[position]->id_];
+				const graph::VertexId vertex = on_board_id + position;
+				//    ,  
+				if (position != 0) {
+					transport_graph.AddEdge({ vertex, stop_id, ComputeEdgeWeight({ bus_id, 0, 0 }) }, { bus_id, 0, 0 });
+				}
+				//         ,  
+				if (position + 1 != trip.size()) {
+					transport_graph.AddEdge({ stop_id, vertex, ComputeEdgeWeight({}) });
+					const graph::EdgeInfo info{ bus_id, 1,
+						static_cast<uint32_t>(catalogue_.GetStopToStopDistance(trip[position], trip[position + 1])) };
+					transport_graph.AddEdge({ vertex, vertex + 1, ComputeEdgeWeight(info) }, info);
+				}
+			}
+			on_board_id += trip.size();
+		}
+
+		return transport_graph;
+	}
 }
\ No newline at end of file
@@ -2,18 +2,101 @@
 
 #include "graph.h"
 #include "router.h"
+#include "dijkstra_router.h"
+#include "contraction_hierarchy.h"
+#include "hub_labels.h"
+#include "connectivity.h"
+#include "pareto_router.h"
+#include "raptor_router.h"
+#include "vertex_order.h"
 #include "transport_catalogue.h"
+#include "lru_cache.h"
 
-#include <map>
+#include <cstdint>
+#include <iostream>
+#include <optional>
 #include <variant>
 
 namespace router {
 
+#ifdef TRANSPORT_CATALOGUE_FIXED_POINT_WEIGHTS
+	//    -     .     ,
+	//          ,   double
+	using Weight = uint32_t;
+#else
+	//    -   
+	using Weight = double;
+#endif
+
+	//        . round_down -  ,    .
+	//       
+	Weight ToWeight(double minutes, bool round_down = false);
+	//        
+	double ToMinutes(Weight weight);
+
+	//   
+	enum class RouterType {
+		//     ,   
+		DIJKSTRA,
+		//        
+		ALL_PAIRS,
+		//   ,  ,     
+		CONTRACTION_HIERARCHIES,
+		//  A*          
+		A_STAR,
+		//     (RAPTOR)    ,    .
+		//     ,   :     
+		//      
+		RAPTOR,
+	};
+
+	//   
+	enum class GraphModel {
+		//            : O(N^2)   
+		COMPLETE,
+		//      " "    :
+		//  ,      , O(N)   
+		LINEAR,
+	};
+
+	//    
+	enum class VertexOrder {
+		//    
+		CREATION,
+		//   -: ,  ,   
+		REVERSE_CUTHILL_MCKEE,
+	};
+
 	struct TransportRouterSettings {
 		//    
 		int bus_wait_time_;
 		//   
 		int bus_velocity_;
+		//   
+		RouterType router_type_ = RouterType::DIJKSTRA;
+		//   
+		GraphModel graph_model_ = GraphModel::COMPLETE;
+		//   ,   make_base
+		VertexOrder vertex_order_ = VertexOrder::CREATION;
+		//    std::cerr   ,  
+		bool memory_report_ = false;
+		// -  ,   . 0 -  
+		size_t route_cache_capacity_ = 0;
+		//          .     
+		bool hub_labels_ = false;
+	};
+
+	//  ,   make_base    
+	struct PrecomputedRouterData {
+		std::optional<graph::Router<Weight>::RoutesInternalData> routes_table;
+		std::optional<graph::ContractionHierarchy<Weight>::HierarchyData> contraction_hierarchy;
+		//        domain::Stop::id_
+		std::vector<graph::VertexId> stop_vertexes;
+		std::optional<graph::HubLabels<Weight>::LabelsData> hub_labels;
+		std::optional<graph::Connectivity::ComponentsData> components;
+		//    ,     ,     
+		int bus_wait_time = 0;
+		int bus_velocity = 0;
 	};
 
 	struct RouteWaitInfo {
@@ -35,33 +118,166 @@ namespace router {
 		std::vector<RoutePointInfo> route_points;
 	};
 
+	//          - 
+	struct ParetoRouteData {
+		RouteData route_data;
+		int transfer_count;
+	};
+
+	struct ReachableStopInfo {
+		std::string_view stop_name;
+		double time;
+	};
+
+	//    :     ,    
+	using TravelTimeMatrix = std::vector<std::vector<std::optional<double>>>;
+
 	class TransportRouter {
 	public:
 		explicit TransportRouter(const Catalogue::TransportCatalogue& catalogue, const TransportRouterSettings& settings);
 		//       
+		//   ,   make_base ( ,  ),
+		//      
 		explicit TransportRouter(
 			const Catalogue::TransportCatalogue& catalogue,
 			const TransportRouterSettings& settings,
-			graph::DirectedWeightedGraph<double>&& graph
+			graph::DirectedWeightedGraph<Weight>&& graph,
+			PrecomputedRouterData&& precomputed = {}
 		);
 
 		std::optional<RouteData> BuildTransportRoute(std::string_view from, std::string_view to);
+		//       ,   :   ,
+		//   ,      . nullopt -    
+		std::optional<double> ComputeTravelTime(std::string_view from, std::string_view to);
+		// ,              - ,
+		//    .        max_extra_time 
+		//  .   -  ,       
+		std::vector<ParetoRouteData> BuildParetoRoutes(std::string_view from, std::string_view to,
+			std::optional<double> max_extra_time = std::nullopt);
+
+		//  count        :   .
+		//   -  ,       
+		std::vector<RouteData> BuildAlternativeRoutes(std::string_view from, std::string_view to, size_t count);
+
+		//        from_stops[i] -> to_stops[j],   .
+		//          .
+		// nullopt -  ,       
+		TravelTimeMatrix ComputeTravelTimeMatrix(
+			const std::vector<std::string_view>& from_stops,
+			const std::vector<std::string_view>& to_stops
+		);
+
+		// ,      from     max_time ,
+		//    . nullopt -  from   ,
+		//   -   max_time
+		std::optional<std::vector<ReachableStopInfo>> ComputeReachableStops(std::string_view from, double max_time);
 
-		const graph::DirectedWeightedGraph<double> GetGraph() const;
+		//  ,  nullptr,    : RAPTOR      ,
+		//   
+		const graph::DirectedWeightedGraph<Weight>* GetGraph() const;
+		//         ,
+		//  nullptr,     
+		const graph::Router<Weight>* GetAllPairsRouter() const;
+		//   ,  nullptr,     
+		const graph::ContractionHierarchy<Weight>* GetContractionHierarchy() const;
+		//   RAPTOR,  nullptr,     
+		const RaptorRouter<Weight>* GetRaptorRouter() const;
+		//   ,  nullptr,    
+		const graph::HubLabels<Weight>* GetHubLabels() const;
+		//        domain::Stop::id_
+		const std::vector<graph::VertexId>& GetStopVertexes() const;
+		//    ,  nullptr,    
+		const graph::Connectivity* GetConnectivity() const;
+
+		//   ,     
+		void PrintMemoryReport(std::ostream& output) const;
+		// -     ,    
+		cache::CacheStats GetRouteCacheStats() const;
 	private:
+		//    A*,        
+		static constexpr double A_STAR_POTENTIAL_MARGIN = 0.99;
+
 		const Catalogue::TransportCatalogue& catalogue_;
-		//     id      
-		std::map<std::string_view, size_t> stop_to_id_;
-		std::map<size_t, std::string_view> id_to_stop_;
+		//      (domain::Stop::id_)     ,
+		// nullptr -     
+		std::vector<graph::VertexId> stop_vertexes_;
+		std::vector<const domain::Stop*> vertex_stops_;
 
 		TransportRouterSettings settings_;
 		
-		graph::DirectedWeightedGraph<double> graph_;
-		graph::Router<double> transport_router_;
+		graph::DirectedWeightedGraph<Weight> graph_;
+		//     ,    settings_.router_type_.
+		//          ,   , . GetDijkstraRouter
+		std::optional<graph::Router<Weight>> all_pairs_router_;
+		std::optional<graph::DijkstraRouter<Weight>> dijkstra_router_;
+		std::optional<graph::ContractionHierarchy<Weight>> contraction_hierarchy_;
+		std::optional<RaptorRouter<Weight>> raptor_router_;
+		//        settings_.hub_labels_
+		std::optional<graph::HubLabels<Weight>> hub_labels_;
+		//   ,         
+		std::optional<graph::Connectivity> connectivity_;
+		//    :   -  
+		std::optional<graph::ParetoRouter<Weight>> pareto_router_;
+
+		//    A*:  ,      ,  
+		//        
+		std::vector<size_t> vertex_stop_indexes_;
+		std::vector<geo::Coordinates> stop_coordinates_;
+		double min_time_per_meter_ = 0;
+
+		//       (from << 32) | to,    
+		cache::ShardedLruCache<uint64_t, std::optional<RouteData>> route_cache_;
+
+		//         graph_
+		void InitializeRouter(PrecomputedRouterData&& precomputed = {});
+		//      : RAPTOR    ,       
+		bool IsGraphRequired() const;
+		//             
+		void InitializeGraphSearch(std::optional<graph::Connectivity::ComponentsData>&& components = std::nullopt);
+		//     ,   ,        
+		void EnsureGraph();
+		//      ,       :
+		//  ,       .   
+		const graph::DijkstraRouter<Weight>& GetDijkstraRouter();
 
 		//         
 		//      
-		graph::DirectedWeightedGraph<double> CreateGraph();
+		graph::DirectedWeightedGraph<Weight> CreateGraph();
+		//     COMPLETE  LINEAR 
+		graph::DirectedWeightedGraph<Weight> CreateCompleteGraph();
+		graph::DirectedWeightedGraph<Weight> CreateLinearGraph();
+
+		//          A*
+		void InitializeAStarPotential();
+		//    A*   to
+		std::optional<graph::DijkstraRouter<Weight>::RouteInfo> BuildAStarRoute(graph::VertexId from, graph::VertexId to) const;
+
+		//   :    n   n * step
+		void NumerateStops(size_t step);
+		//         settings_.vertex_order_
+		void ReorderVertexes();
+		//  vertex_stops_   stop_vertexes_
+		void IndexStopVertexes(size_t vertex_count);
+		//     stop_name, nullopt -    
+		std::optional<graph::VertexId> FindStopVertex(std::string_view stop_name) const;
+		// ,    vertex,  nullptr
+		const domain::Stop* GetVertexStop(graph::VertexId vertex) const;
+		//     from  to    
+		std::optional<RouteData> ComputeTransportRoute(graph::VertexId from, graph::VertexId to);
+		//       
+		RouteData MakeRouteData(Weight weight, const std::vector<graph::EdgeId>& edges) const;
+		//      ,  RAPTOR
+		RouteData MakeRouteData(const RaptorRouter<Weight>::RouteInfo& route) const;
+		//     bus_id      from   to    max_distance
+		bool HasDirectRide(graph::VertexId from, graph::VertexId to, uint32_t bus_id, uint32_t max_distance) const;
+		//     ,       ,        
+		bool HasNeedlessReboarding(const std::vector<graph::EdgeId>& edges) const;
+		//    distance ( ),  
+		double ComputeRideTime(double distance) const;
+		//             
+		Weight ComputeEdgeWeight(const graph::EdgeInfo& edge_info) const;
+		//        ,    
+		void CustomizeWeights();
 	};
 
 }
\ No newline at end of file
@@ -0,0 +1,97 @@
+#pragma once
+
+#include "graph.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <vector>
+
+namespace graph {
+
+    // Нумерация вершин обратным алгоритмом Катхилла-Макки (RCM): обход в ширину по графу без учёта
+    // направления рёбер, соседи вершины - в порядке возрастания степени, каждая компонента - с вершины
+    // наименьшей степени, затем порядок обращается. Концы рёбер получают близкие номера, поэтому
+    // поиск и строки таблицы маршрутов обращаются к соседним участкам памяти.
+    // Возвращает новый номер каждой вершины по её текущему номеру
+    template <typename Weight>
+    std::vector<VertexId> ComputeReverseCuthillMcKeeOrder(const DirectedWeightedGraph<Weight>& graph) {
+        const size_t vertex_count = graph.GetVertexCount();
+        const auto& edges = graph.GetEdges();
+
+        // Соседи вершин без учёта направления в CSR представлении
+        std::vector<size_t> offsets(vertex_count + 1, 0);
+        for (const auto& edge : edges) {
+            ++offsets[edge.from + 1];
+            ++offsets[edge.to + 1];
+        }
+        for (VertexId vertex = 0; vertex < vertex_count; ++vertex) {
+            offsets[vertex + 1] += offsets[vertex];
+        }
+        std::vector<uint32_t> neighbours(offsets.back());
+        std::vector<size_t> positions(offsets.begin(), offsets.end() - 1);
+        for (const auto& edge : edges) {
+            neighbours[positions[edge.from]++] = static_cast<uint32_t>(edge.to);
+            neighbours[positions[edge.to]++] = static_cast<uint32_t>(edge.from);
+        }
+        auto degree = [&offsets](VertexId vertex) {
+            return offsets[vertex + 1] - offsets[vertex];
+        };
+        for (VertexId vertex = 0; vertex < vertex_count; ++vertex) {
+            std::stable_sort(neighbours.begin() + offsets[vertex], neighbours.begin() + offsets[vertex + 1],
+                [&degree](uint32_t lhs, uint32_t rhs) {
+                    return degree(lhs) < degree(rhs);
+                });
+        }
+
+        // Корни обхода - непосещённые вершины в порядке возрастания степени
+        std::vector<uint32_t> roots(vertex_count);
+        std::iota(roots.begin(), roots.end(), 0);
+        std::stable_sort(roots.begin(), roots.end(), [&degree](uint32_t lhs, uint32_t rhs) {
+            return degree(lhs) < degree(rhs);
+        });
+
+        // Очередь обхода в ширину одновременно является порядком Катхилла-Макки
+        std::vector<uint32_t> order;
+        order.reserve(vertex_count);
+        std::vector<uint8_t> is_visited(vertex_count, 0);
+        for (const uint32_t root : roots) {
+            if (is_visited[root]) {
+                continue;
+            }
+            is_visited[root] = 1;
+            order.push_back(root);
+            for (size_t head = order.size() - 1; head < order.size(); ++head) {
+                const uint32_t vertex = order[head];
+                for (size_t position = offsets[vertex]; position < offsets[vertex + 1]; ++position) {
+                    const uint32_t neighbour = neighbours[position];
+                    if (!is_visited[neighbour]) {
+                        is_visited[neighbour] = 1;
+                        order.push_back(neighbour);
+                    }
+                }
+            }
+        }
+
+        std::vector<VertexId> new_ids(vertex_count);
+        for (size_t position = 0; position < vertex_count; ++position) {
+            new_ids[order[position]] = vertex_count - 1 - position;
+        }
+        return new_ids;
+    }
+
+    // Средний модуль разности номеров концов рёбер: чем он меньше, тем ближе в памяти данные соседних вершин
+    template <typename Weight>
+    double ComputeMeanEdgeVertexGap(const DirectedWeightedGraph<Weight>& graph) {
+        const auto& edges = graph.GetEdges();
+        if (edges.empty()) {
+            return 0;
+        }
+        double gap_sum = 0;
+        for (const auto& edge : edges) {
+            gap_sum += edge.from < edge.to ? edge.to - edge.from : edge.from - edge.to;
+        }
+        return gap_sum / edges.size();
+    }
+
+}  // namespace graph